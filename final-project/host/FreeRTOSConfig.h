@@ -0,0 +1,167 @@
+/*
+ * FreeRTOS Kernel V10.4.3
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Host (POSIX port) configuration for the scheduler variants.
+ *
+ * Mirrors src-RM-DM/FreeRTOSConfig.h and src-EDF/FreeRTOSConfig.h, except
+ * for the parts that are specific to the ATmega (watchdog tick, stack sizes).
+ *----------------------------------------------------------*/
+
+/* Set schedUSE_TIMER1_TICK to 1 for the tick period schedTICK_PERIOD_US of the
+ * ATmega's Timer1 tick, see src-RM-DM/FreeRTOSConfig.h. */
+#ifndef schedUSE_TIMER1_TICK
+    #define schedUSE_TIMER1_TICK 0
+#endif
+
+/* Virtual tick rate. Same as the tick of the ATmega port, by default the 15 ms
+ * watchdog tick ( 128000 >> ( WDTO_15MS + 11 ) ), so task sets expressed with
+ * pdMS_TO_TICKS come out in exactly the same number of ticks on the host. */
+#if( schedUSE_TIMER1_TICK == 1 )
+    #ifndef schedTICK_PERIOD_US
+        #define schedTICK_PERIOD_US 1000
+    #endif
+    #define hostVIRTUAL_TICK_RATE_HZ        ( 1000000UL / schedTICK_PERIOD_US )
+#else
+    #define hostVIRTUAL_TICK_RATE_HZ        62
+#endif
+
+/* Number of virtual ticks that are run per real-time virtual tick period.
+ * The POSIX port's timer is programmed with the accelerated rate. */
+#ifndef hostTIME_ACCELERATION
+    #define hostTIME_ACCELERATION           1000
+#endif
+
+/* The program exits after this many virtual ticks. Default is 24 hours. */
+#ifndef hostRUN_FOR_TICKS
+    #define hostRUN_FOR_TICKS               ( 24UL * 60UL * 60UL * hostVIRTUAL_TICK_RATE_HZ )
+#endif
+
+#define configUSE_PREEMPTION                1
+/* The idle hook runs loop(), as the Arduino library does. */
+#define configUSE_IDLE_HOOK                 1
+#define configUSE_TICK_HOOK                 1
+#define configTICK_RATE_HZ                  ( hostVIRTUAL_TICK_RATE_HZ * hostTIME_ACCELERATION )
+#define configMAX_PRIORITIES                7
+#define configIDLE_SHOULD_YIELD             1
+/* The POSIX port runs every task on a pthread, which needs PTHREAD_STACK_MIN. */
+#define configMINIMAL_STACK_SIZE            ( ( unsigned short ) 4096 )
+#define configMAX_TASK_NAME_LEN             ( 8 )
+#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 1024 * 1024 ) )
+
+#define configQUEUE_REGISTRY_SIZE           0
+#define configCHECK_FOR_STACK_OVERFLOW      0
+
+#define configUSE_TRACE_FACILITY            0
+/* 32-bit ticks, the POSIX port computes its timer interval in TickType_t. */
+#define configUSE_16_BIT_TICKS              0
+
+#define configUSE_MUTEXES                   1
+#define configUSE_RECURSIVE_MUTEXES         1
+#define configUSE_COUNTING_SEMAPHORES       1
+#define configUSE_TIME_SLICING              1
+#define configUSE_QUEUE_SETS                0
+#define configUSE_MALLOC_FAILED_HOOK        0
+
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+/* Set to 1 by the Makefile for schedUSE_STATIC_ALLOCATION. */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+    #define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+/* Timer definitions. */
+#define configUSE_TIMERS                    0
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES               0
+#define configMAX_CO_ROUTINE_PRIORITIES     ( (UBaseType_t ) 2 )
+
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 2
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskCleanUpResources           1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vResumeFromISR                  1
+#define INCLUDE_xTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetIdleTaskHandle          1 // create an idle task handle.
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+
+/* Ticks are counted in virtual time, independent of configTICK_RATE_HZ. */
+#define pdMS_TO_TICKS( xTimeInMs )    ( ( TickType_t ) ( ( ( TickType_t ) ( xTimeInMs ) * ( TickType_t ) hostVIRTUAL_TICK_RATE_HZ ) / ( TickType_t ) 1000U ) )
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vHostAssertCalled( const char *pcFile, unsigned long ulLine );
+void vHostTickCount( unsigned long ulTickCount );
+
+#ifdef __cplusplus
+}
+#endif
+
+#define configASSERT( x ) if( ( x ) == 0 ) { vHostAssertCalled( __FILE__, __LINE__ ); }
+
+/* Ends the run after hostRUN_FOR_TICKS virtual ticks. */
+#define traceTASK_INCREMENT_TICK( xTickCount )    vHostTickCount( ( unsigned long ) ( xTickCount ) )
+
+/* Virtual CPU cycles per real microsecond and per virtual tick, for the
+ * scheduler's cycle clock. */
+#define hostCYCLES_PER_US                   ( ( F_CPU / 1000000UL ) * hostTIME_ACCELERATION )
+#define schedCYCLES_PER_TICK                ( ( uint32_t ) ( F_CPU / hostVIRTUAL_TICK_RATE_HZ ) )
+
+/* Set schedUSE_EXACT_EXEC_TIME to 1 to charge jobs their execution time in
+ * virtual cycles from switch in to switch out, see scheduler.h. The budget is
+ * checked every tick, the host has no compare interrupt. */
+#ifndef schedUSE_EXACT_EXEC_TIME
+    #define schedUSE_EXACT_EXEC_TIME 0
+#endif
+
+#if( schedUSE_EXACT_EXEC_TIME == 1 )
+#ifdef __cplusplus
+extern "C" {
+#endif
+    void vSchedulerTaskSwitchedIn( void );
+    void vSchedulerTaskSwitchedOut( void );
+#ifdef __cplusplus
+}
+#endif
+#define traceTASK_SWITCHED_IN()     vSchedulerTaskSwitchedIn()
+#define traceTASK_SWITCHED_OUT()    vSchedulerTaskSwitchedOut()
+#endif /* schedUSE_EXACT_EXEC_TIME */
+
+#endif /* FREERTOS_CONFIG_H */
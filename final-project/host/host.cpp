@@ -0,0 +1,139 @@
+/* Host (POSIX) support code for running the scheduler variants with
+ * accelerated virtual time. See ../README.md. */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Arduino_FreeRTOS.h>
+#include <Arduino.h>
+#include <util/delay_basic.h>
+
+HostSerial Serial;
+
+/* Writes straight to stdout. stdio's FILE lock must not be used here: a task
+ * can be switched out by the tick signal while it holds the lock. */
+static void prvHostWrite( const char *pcBuffer, size_t xLength )
+{
+	while( xLength > 0 )
+	{
+		ssize_t xWritten = write( STDOUT_FILENO, pcBuffer, xLength );
+		if( xWritten <= 0 )
+		{
+			return;
+		}
+		pcBuffer += xWritten;
+		xLength -= ( size_t ) xWritten;
+	}
+}
+
+void HostSerial::print( const char *pcString )
+{
+	const char *pcEnd = pcString;
+	while( '\0' != *pcEnd )
+	{
+		pcEnd++;
+	}
+	prvHostWrite( pcString, ( size_t ) ( pcEnd - pcString ) );
+}
+
+void HostSerial::print( char cChar )
+{
+	prvHostWrite( &cChar, 1 );
+}
+
+void HostSerial::print( long lValue )
+{
+	char buffer[ 24 ];
+	int iLength = snprintf( buffer, sizeof( buffer ), "%ld", lValue );
+	prvHostWrite( buffer, ( size_t ) iLength );
+}
+
+void HostSerial::print( unsigned long ulValue )
+{
+	char buffer[ 24 ];
+	int iLength = snprintf( buffer, sizeof( buffer ), "%lu", ulValue );
+	prvHostWrite( buffer, ( size_t ) iLength );
+}
+
+extern "C" void vHostPrintf( const char *pcFormat, ... )
+{
+	char buffer[ 100 ];
+	va_list xArgs;
+
+	va_start( xArgs, pcFormat );
+	int iLength = vsnprintf( buffer, sizeof( buffer ), pcFormat, xArgs );
+	va_end( xArgs );
+
+	if( iLength > 0 )
+	{
+		if( iLength >= ( int ) sizeof( buffer ) )
+		{
+			iLength = sizeof( buffer ) - 1;
+		}
+		prvHostWrite( buffer, ( size_t ) iLength );
+	}
+}
+
+/* Burns the calling thread's CPU time for the given number of target cycles.
+ * Thread CPU time only advances while the FreeRTOS task is running, so time
+ * spent preempted is not counted, the same as a busy loop on the ATmega. */
+extern "C" void vHostDelayCycles( unsigned long ulCycles )
+{
+	struct timespec xNow;
+	unsigned long long ullStart, ullEnd;
+
+	clock_gettime( CLOCK_THREAD_CPUTIME_ID, &xNow );
+	ullStart = ( unsigned long long ) xNow.tv_sec * 1000000000ULL + ( unsigned long long ) xNow.tv_nsec;
+	ullEnd = ullStart + ( ( unsigned long long ) ulCycles * 1000000000ULL ) / ( ( unsigned long long ) F_CPU * hostTIME_ACCELERATION );
+
+	do
+	{
+		clock_gettime( CLOCK_THREAD_CPUTIME_ID, &xNow );
+	} while( ( unsigned long long ) xNow.tv_sec * 1000000000ULL + ( unsigned long long ) xNow.tv_nsec < ullEnd );
+}
+
+/* Called from the tick interrupt (signal handler) with the tick count before
+ * it is incremented. Only async-signal-safe calls are allowed here. */
+extern "C" void vHostTickCount( unsigned long ulTickCount )
+{
+	if( ulTickCount >= hostRUN_FOR_TICKS )
+	{
+		static const char pcEnd[] = "----- Host Run Ended -----\n";
+		prvHostWrite( pcEnd, sizeof( pcEnd ) - 1 );
+		_exit( EXIT_SUCCESS );
+	}
+}
+
+extern "C" void vHostAssertCalled( const char *pcFile, unsigned long ulLine )
+{
+	vHostPrintf( "ASSERT: %s:%lu\n", pcFile, ulLine );
+	_exit( EXIT_FAILURE );
+}
+
+void loop( void );
+
+/* The Arduino library's idle hook runs the sketch's loop(), which prints the
+ * deferred PRINTF records. */
+void vApplicationIdleHook( void )
+{
+	loop();
+}
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+/* Memory of the idle task, the kernel asks for it when static allocation is
+ * enabled. */
+extern "C" void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, configSTACK_DEPTH_TYPE *pulIdleTaskStackSize )
+{
+	static StaticTask_t xIdleTaskTCB;
+	static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
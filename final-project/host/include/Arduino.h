@@ -0,0 +1,31 @@
+#ifndef ARDUINO_H_
+#define ARDUINO_H_
+
+/* Minimal host stand-in for the parts of the Arduino core used by the
+ * sketches and the kernel: the Serial object. */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+class HostSerial
+{
+public:
+	void begin( unsigned long ulBaud ) { ( void ) ulBaud; }
+	void print( const char *pcString );
+	void print( char cChar );
+	void print( long lValue );
+	void print( unsigned long ulValue );
+	void print( int iValue ) { print( ( long ) iValue ); }
+	void print( unsigned int uiValue ) { print( ( unsigned long ) uiValue ); }
+	void write( uint8_t ucByte ) { print( ( char ) ucByte ); }
+	template< typename T > void println( T xValue ) { print( xValue ); print( '\n' ); }
+	void println( void ) { print( '\n' ); }
+	operator bool() const { return true; }
+};
+
+extern HostSerial Serial;
+
+#endif /* __cplusplus */
+
+#endif /* ARDUINO_H_ */
@@ -0,0 +1,129 @@
+#ifndef INC_ARDUINO_FREERTOS_H
+#define INC_ARDUINO_FREERTOS_H
+
+/* Host replacement for the Arduino_FreeRTOS.h of the scheduler variants.
+ * Provides the same PRINTF macro on top of the stock FreeRTOS.h of the POSIX port.
+ * schedLOG_DEFERRED is the same switch as on the ATmega. */
+
+#ifndef DEBUG
+	#define DEBUG 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vHostPrintf( const char *pcFormat, ... ) __attribute__ ( ( format ( printf, 1, 2 ) ) );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Set schedLOG_DEFERRED to 0 to format and print in place again. Otherwise
+ * PRINTF in C++ code only stores a fixed-size record of the format and its
+ * arguments, the scheduler prints the records later from the idle task, see
+ * vSchedulerLogDrain(). */
+#ifndef schedLOG_DEFERRED
+	#define schedLOG_DEFERRED 1
+#endif
+
+/* Set schedLOG_TOKENIZED to 1 (with schedLOG_DEFERRED 1) to replace each
+ * format by its index in log_table.h. The format strings are then only used
+ * at compile time, and the records are sent as binary frames, which
+ * final-project/host/logtoken decodes back to text. */
+#ifndef schedLOG_TOKENIZED
+	#define schedLOG_TOKENIZED 0
+#endif
+
+#if( DEBUG && schedLOG_DEFERRED == 1 && defined( __cplusplus ) )
+
+	/* Most arguments a single PRINTF can take. */
+	#define schedLOG_MAX_ARGS 5
+
+	/* One PRINTF argument. Integers are widened to long, strings are kept by
+	 * pointer and must outlive the record (names, literals, __func__). */
+	typedef union
+	{
+		long lValue;
+		const void *pvValue;
+	} SchedLogArg_t;
+
+	#if( schedLOG_TOKENIZED == 1 )
+		#include "log_table.h"
+
+		/* Index of the format in pcSchedulerLogTable. */
+		typedef unsigned char SchedLogFormat_t;
+
+		/* 0xFF is the frame that reports dropped records. */
+		static_assert( sizeof( pcSchedulerLogTable ) / sizeof( pcSchedulerLogTable[ 0 ] ) < 0xFF, "Too many PRINTF formats for 1-byte IDs" );
+
+		constexpr bool xSchedulerLogEqual( const char *pcA, const char *pcB )
+		{
+			return ( *pcA == *pcB ) && ( '\0' == *pcA || xSchedulerLogEqual( pcA + 1, pcB + 1 ) );
+		}
+
+		/* Returns the index of pcFormat in pcSchedulerLogTable, or -1. */
+		constexpr int iSchedulerLogId( const char *pcFormat, unsigned int uxId = 0 )
+		{
+			return ( sizeof( pcSchedulerLogTable ) / sizeof( pcSchedulerLogTable[ 0 ] ) == uxId ) ? -1 :
+				( xSchedulerLogEqual( pcFormat, pcSchedulerLogTable[ uxId ] ) ? ( int ) uxId : iSchedulerLogId( pcFormat, uxId + 1 ) );
+		}
+	#else
+		typedef const char *SchedLogFormat_t;
+	#endif /* schedLOG_TOKENIZED */
+
+	/* Stores a record, from any context. Drops it when the ring is full.
+	 * Bit n of ucStrings is set when argument n is a string. */
+	void vSchedulerLogWrite( SchedLogFormat_t xFormat, unsigned char ucStrings, const SchedLogArg_t *pxArgs, unsigned char ucArgs );
+	/* Prints the stored records. Must only be called from one task, loop(). */
+	void vSchedulerLogDrain( void );
+
+	inline SchedLogArg_t xSchedulerLogArg( long lValue ) { SchedLogArg_t xArg; xArg.lValue = lValue; return xArg; }
+	inline SchedLogArg_t xSchedulerLogArg( unsigned long ulValue ) { return xSchedulerLogArg( ( long ) ulValue ); }
+	inline SchedLogArg_t xSchedulerLogArg( int iValue ) { return xSchedulerLogArg( ( long ) iValue ); }
+	inline SchedLogArg_t xSchedulerLogArg( unsigned int uiValue ) { return xSchedulerLogArg( ( long ) uiValue ); }
+	inline SchedLogArg_t xSchedulerLogArg( signed char cValue ) { return xSchedulerLogArg( ( long ) cValue ); }
+	inline SchedLogArg_t xSchedulerLogArg( unsigned char ucValue ) { return xSchedulerLogArg( ( long ) ucValue ); }
+	inline SchedLogArg_t xSchedulerLogArg( char cValue ) { return xSchedulerLogArg( ( long ) cValue ); }
+	inline SchedLogArg_t xSchedulerLogArg( const void *pvValue ) { SchedLogArg_t xArg; xArg.pvValue = pvValue; return xArg; }
+
+	/* Bit mask of the arguments that are strings (pointers). */
+	template< typename T > struct xSchedulerLogIsString { enum { uxValue = 0 }; };
+	template< typename T > struct xSchedulerLogIsString< T * > { enum { uxValue = 1 }; };
+	template< typename... Args > struct xSchedulerLogStrings { enum { uxMask = 0 }; };
+	template< typename T, typename... Args > struct xSchedulerLogStrings< T, Args... >
+	{
+		enum { uxMask = xSchedulerLogIsString< T >::uxValue | ( xSchedulerLogStrings< Args... >::uxMask << 1 ) };
+	};
+
+	template< typename... Args >
+	inline void vSchedulerLog( SchedLogFormat_t xFormat, Args... xArgs )
+	{
+		static_assert( sizeof...( Args ) <= schedLOG_MAX_ARGS, "Too many PRINTF arguments" );
+		const SchedLogArg_t xLogArgs[ sizeof...( Args ) + 1 ] = { xSchedulerLogArg( xArgs )... };
+		vSchedulerLogWrite( xFormat, xSchedulerLogStrings< Args... >::uxMask, xLogArgs, sizeof...( Args ) );
+	}
+
+	#if( schedLOG_TOKENIZED == 1 )
+		#define PRINTF(format, ...) { enum { eLogId = iSchedulerLogId( format ) }; \
+			static_assert( eLogId >= 0, "PRINTF format missing from log_table.h, run make logtable" ); \
+			vSchedulerLog( ( SchedLogFormat_t ) eLogId, ##__VA_ARGS__ ); }
+	#else
+		#define PRINTF(format, ...) { vSchedulerLog(format, ##__VA_ARGS__); }
+	#endif /* schedLOG_TOKENIZED */
+
+#elif DEBUG
+
+	#define PRINTF(format, ...) { vHostPrintf(format, ##__VA_ARGS__); }
+	#define vSchedulerLogDrain()
+
+#else
+
+	#define PRINTF(format, ...)
+	#define vSchedulerLogDrain()
+
+#endif
+
+#include "FreeRTOS.h"
+
+#endif /* INC_ARDUINO_FREERTOS_H */
@@ -0,0 +1,6 @@
+#ifndef FREERTOS_VARIANT_H_
+#define FREERTOS_VARIANT_H_
+
+/* Nothing is board specific on the host; see ../FreeRTOSConfig.h. */
+
+#endif /* FREERTOS_VARIANT_H_ */
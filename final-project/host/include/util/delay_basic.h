@@ -0,0 +1,33 @@
+#ifndef UTIL_DELAY_BASIC_H_
+#define UTIL_DELAY_BASIC_H_
+
+/* Host stand-in for avr-libc's busy loops. The loops burn the calling
+ * thread's CPU time that the same number of cycles would take at F_CPU,
+ * scaled by hostTIME_ACCELERATION, so preemption is accounted for exactly
+ * as on the target. */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vHostDelayCycles( unsigned long ulCycles );
+
+#ifdef __cplusplus
+}
+#endif
+
+/* 3 cycles per iteration. */
+static inline void _delay_loop_1( uint8_t __count )
+{
+	vHostDelayCycles( 3UL * ( __count ? __count : 256UL ) );
+}
+
+/* 4 cycles per iteration. */
+static inline void _delay_loop_2( uint16_t __count )
+{
+	vHostDelayCycles( 4UL * ( __count ? __count : 65536UL ) );
+}
+
+#endif /* UTIL_DELAY_BASIC_H_ */
@@ -0,0 +1,582 @@
+/* String table generator and decoder for the tokenized PRINTF of the
+ * scheduler variants (schedLOG_TOKENIZED in Arduino_FreeRTOS.h).
+ *
+ *     logtoken -g <log_table.h> <source>...
+ *
+ * collects the format of every PRINTF call in the sources, in order of first
+ * appearance, and writes them to log_table.h. The index of a format in the
+ * table is the 1-byte ID the target sends instead of the text.
+ *
+ *     logtoken <log_table.h> [capture]
+ *
+ * decodes a serial capture (stdin by default) back to the text PRINTF would
+ * have printed. Text up to the "--LOG TOKENS L<n> I<m>--" line that the target
+ * sends first is copied as is, then every frame is
+ *
+ *     <ID> <argument>...
+ *
+ * where a %s argument is a NUL-terminated string and any other argument is a
+ * zigzag encoded varint of a long of <n> bytes. Conversions without a length
+ * modifier print it as an int of <m> bytes, <n> / 2 when the header has no
+ * I<m>, as the target's printf did. ID 0xFF is followed by one
+ * varint, the number of records the target dropped. After an unknown ID the
+ * decoder copies text again until the next header line. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define logMAX_FORMATS			255		/* IDs 0 to 254, 0xFF is the dropped-records frame. */
+#define logMAX_FORMAT_LEN		256
+#define logDROPPED_ID			0xFF	/* schedLOG_DROPPED_ID */
+#define logHEADER				"--LOG TOKENS L"
+
+static char cFormats[ logMAX_FORMATS ][ logMAX_FORMAT_LEN ];
+static int iFormatCount = 0;
+
+/* Parses the C string literal at pc, appends its value to pcOut and returns
+ * the position after the closing quote, or NULL if it is not terminated. */
+static const char *prvParseLiteral( const char *pc, char *pcOut, size_t *pxLength )
+{
+	pc++;
+	while( '"' != *pc )
+	{
+		char c = *pc++;
+
+		if( '\0' == c || '\n' == c )
+		{
+			return NULL;
+		}
+		if( '\\' == c )
+		{
+			c = *pc++;
+			switch( c )
+			{
+				case 'n': c = '\n'; break;
+				case 't': c = '\t'; break;
+				case 'r': c = '\r'; break;
+				case '0': c = '\0'; break;
+				case '\0': return NULL;
+				default: break;		/* \" \\ \' */
+			}
+		}
+		if( *pxLength + 1 < logMAX_FORMAT_LEN )
+		{
+			pcOut[ ( *pxLength )++ ] = c;
+		}
+	}
+	pcOut[ *pxLength ] = '\0';
+
+	return pc + 1;
+}
+
+/* Parses one or more adjacent string literals, as the compiler joins them. */
+static const char *prvParseLiterals( const char *pc, char *pcOut )
+{
+	size_t xLength = 0;
+	const char *pcEnd = NULL;
+
+	pcOut[ 0 ] = '\0';
+	for( ; ; )
+	{
+		while( ' ' == *pc || '\t' == *pc || '\r' == *pc || '\n' == *pc )
+		{
+			pc++;
+		}
+		if( '"' != *pc )
+		{
+			return pcEnd;
+		}
+		pc = prvParseLiteral( pc, pcOut, &xLength );
+		if( NULL == pc )
+		{
+			return NULL;
+		}
+		pcEnd = pc;
+	}
+}
+
+static int prvAddFormat( const char *pcFormat )
+{
+	for( int i = 0; i < iFormatCount; i++ )
+	{
+		if( 0 == strcmp( cFormats[ i ], pcFormat ) )
+		{
+			return 1;
+		}
+	}
+	if( logMAX_FORMATS == iFormatCount )
+	{
+		fprintf( stderr, "more than %d PRINTF formats, they no longer fit in 1-byte IDs\n", logMAX_FORMATS );
+		return 0;
+	}
+	strcpy( cFormats[ iFormatCount++ ], pcFormat );
+
+	return 1;
+}
+
+static char *prvReadFile( const char *pcPath )
+{
+	FILE *pxFile = fopen( pcPath, "rb" );
+	char *pcText;
+	long lSize;
+
+	if( NULL == pxFile )
+	{
+		perror( pcPath );
+		return NULL;
+	}
+	fseek( pxFile, 0, SEEK_END );
+	lSize = ftell( pxFile );
+	fseek( pxFile, 0, SEEK_SET );
+	pcText = ( char * ) malloc( ( size_t ) lSize + 1 );
+	if( NULL != pcText )
+	{
+		pcText[ fread( pcText, 1, ( size_t ) lSize, pxFile ) ] = '\0';
+	}
+	fclose( pxFile );
+
+	return pcText;
+}
+
+/* Adds the format of every PRINTF("..." call in the file. */
+static int prvScanSource( const char *pcPath )
+{
+	char *pcText = prvReadFile( pcPath );
+	char cFormat[ logMAX_FORMAT_LEN ];
+	int xResult = 1;
+
+	if( NULL == pcText )
+	{
+		return 0;
+	}
+
+	for( const char *pc = strstr( pcText, "PRINTF" ); NULL != pc && xResult; pc = strstr( pc + 1, "PRINTF" ) )
+	{
+		const char *pcNext = pc + 6;
+
+		/* Whole identifier only, VPRINTF or PRINTF_X are something else. */
+		if( ( pc > pcText && ( '_' == pc[ -1 ] || ( pc[ -1 ] >= 'A' && pc[ -1 ] <= 'Z' ) || ( pc[ -1 ] >= 'a' && pc[ -1 ] <= 'z' ) ) ) ||
+			'_' == *pcNext || ( *pcNext >= 'A' && *pcNext <= 'Z' ) )
+		{
+			continue;
+		}
+		while( ' ' == *pcNext || '\t' == *pcNext )
+		{
+			pcNext++;
+		}
+		if( '(' != *pcNext )
+		{
+			continue;
+		}
+		/* The #define has a parameter name here, not a literal. */
+		if( NULL != prvParseLiterals( pcNext + 1, cFormat ) )
+		{
+			xResult = prvAddFormat( cFormat );
+		}
+	}
+	free( pcText );
+
+	return xResult;
+}
+
+static void prvWriteLiteral( FILE *pxOut, const char *pc )
+{
+	fputc( '"', pxOut );
+	for( ; '\0' != *pc; pc++ )
+	{
+		switch( *pc )
+		{
+			case '\n': fputs( "\\n", pxOut ); break;
+			case '\t': fputs( "\\t", pxOut ); break;
+			case '\r': fputs( "\\r", pxOut ); break;
+			case '"': fputs( "\\\"", pxOut ); break;
+			case '\\': fputs( "\\\\", pxOut ); break;
+			default: fputc( *pc, pxOut ); break;
+		}
+	}
+	fputc( '"', pxOut );
+}
+
+static int prvGenerate( const char *pcTable, int iSources, char **ppcSources )
+{
+	FILE *pxOut;
+
+	for( int i = 0; i < iSources; i++ )
+	{
+		if( !prvScanSource( ppcSources[ i ] ) )
+		{
+			return 0;
+		}
+	}
+
+	pxOut = fopen( pcTable, "w" );
+	if( NULL == pxOut )
+	{
+		perror( pcTable );
+		return 0;
+	}
+	fprintf( pxOut, "/* PRINTF formats for schedLOG_TOKENIZED, the index of a format is the ID\n"
+					" * sent in its frames. Generated by final-project/host/logtoken -g from\n *  " );
+	for( int i = 0; i < iSources; i++ )
+	{
+		const char *pcName = strrchr( ppcSources[ i ], '/' );
+		fprintf( pxOut, " %s", NULL != pcName ? pcName + 1 : ppcSources[ i ] );
+	}
+	fprintf( pxOut, "\n * Regenerate it after changing a PRINTF format. */\n\n"
+					"#ifndef LOG_TABLE_H_\n#define LOG_TABLE_H_\n\n"
+					"static constexpr const char *pcSchedulerLogTable[] =\n{\n" );
+	for( int i = 0; i < iFormatCount; i++ )
+	{
+		fputc( '\t', pxOut );
+		prvWriteLiteral( pxOut, cFormats[ i ] );
+		fputs( i + 1 < iFormatCount ? ",\n" : "\n", pxOut );
+	}
+	fprintf( pxOut, "};\n\n#endif /* LOG_TABLE_H_ */\n" );
+	fclose( pxOut );
+
+	fprintf( stderr, "%s: %d formats\n", pcTable, iFormatCount );
+
+	return 1;
+}
+
+/* Loads the formats from the lines of log_table.h that start with a literal. */
+static int prvLoadTable( const char *pcTable )
+{
+	char *pcText = prvReadFile( pcTable );
+	char cFormat[ logMAX_FORMAT_LEN ];
+
+	if( NULL == pcText )
+	{
+		return 0;
+	}
+	for( const char *pcLine = pcText; '\0' != *pcLine; )
+	{
+		const char *pc = pcLine;
+
+		while( ' ' == *pc || '\t' == *pc )
+		{
+			pc++;
+		}
+		if( '"' == *pc && NULL != prvParseLiterals( pc, cFormat ) && !prvAddFormat( cFormat ) )
+		{
+			free( pcText );
+			return 0;
+		}
+		pcLine = strchr( pcLine, '\n' );
+		pcLine = ( NULL != pcLine ) ? pcLine + 1 : "";
+	}
+	free( pcText );
+
+	if( 0 == iFormatCount )
+	{
+		fprintf( stderr, "%s: no formats\n", pcTable );
+		return 0;
+	}
+
+	return 1;
+}
+
+static long long llOffset = 0;
+
+static int prvGetByte( FILE *pxIn )
+{
+	int c = getc( pxIn );
+
+	if( EOF != c )
+	{
+		llOffset++;
+	}
+
+	return c;
+}
+
+/* Reads a varint. Returns 0 at the end of the capture. */
+static int prvGetVarint( FILE *pxIn, uint64_t *pullValue )
+{
+	uint64_t ullValue = 0;
+
+	for( int iShift = 0; iShift < 64; iShift += 7 )
+	{
+		int c = prvGetByte( pxIn );
+
+		if( EOF == c )
+		{
+			return 0;
+		}
+		ullValue |= ( uint64_t ) ( c & 0x7F ) << iShift;
+		if( 0 == ( c & 0x80 ) )
+		{
+			break;
+		}
+	}
+	*pullValue = ullValue;
+
+	return 1;
+}
+
+/* Prints one frame with the format of ID iId. Each conversion is printed on
+ * its own with the argument read from the capture, as the target's
+ * prvLogFormat does. Returns 0 at the end of the capture. */
+static int prvDecodeFrame( FILE *pxIn, int iId, int iLongBytes, int iIntBytes )
+{
+	const char *pcFormat = cFormats[ iId ];
+	char cSpec[ 16 ];
+	char cString[ 256 ];
+
+	while( '\0' != *pcFormat )
+	{
+		if( '%' != *pcFormat )
+		{
+			putchar( *pcFormat++ );
+			continue;
+		}
+
+		size_t xSpec = 0;
+		int iLong = 0;
+		int iShort = 0;
+		cSpec[ xSpec++ ] = *pcFormat++;
+		while( xSpec < sizeof( cSpec ) - 4 && NULL != strchr( "-+ #.0123456789", *pcFormat ) && '\0' != *pcFormat )
+		{
+			cSpec[ xSpec++ ] = *pcFormat++;
+		}
+		while( 'l' == *pcFormat || 'h' == *pcFormat )
+		{
+			if( 'l' == *pcFormat++ )
+			{
+				iLong++;
+			}
+			else
+			{
+				iShort++;
+			}
+		}
+
+		char cConversion = *pcFormat;
+		if( '\0' == cConversion )
+		{
+			break;
+		}
+		pcFormat++;
+
+		if( '%' == cConversion )
+		{
+			putchar( '%' );
+		}
+		else if( 's' == cConversion )
+		{
+			size_t xLength = 0;
+			int c;
+
+			while( 0 != ( c = prvGetByte( pxIn ) ) )
+			{
+				if( EOF == c )
+				{
+					return 0;
+				}
+				if( xLength + 1 < sizeof( cString ) )
+				{
+					cString[ xLength++ ] = ( char ) c;
+				}
+			}
+			cString[ xLength ] = '\0';
+			cSpec[ xSpec++ ] = 's';
+			cSpec[ xSpec ] = '\0';
+			printf( cSpec, cString );
+		}
+		else
+		{
+			uint64_t ullZigzag;
+			int64_t llValue;
+
+			if( !prvGetVarint( pxIn, &ullZigzag ) )
+			{
+				return 0;
+			}
+			llValue = ( int64_t ) ( ullZigzag >> 1 ) ^ -( int64_t ) ( ullZigzag & 1 );
+
+			/* Size of the type the length modifier names on the target. */
+			int iBytes = ( iLong > 1 ) ? 8 : ( 1 == iLong ) ? iLongBytes : ( iShort > 1 ) ? 1 : ( 1 == iShort ) ? 2 : iIntBytes;
+			uint64_t ullValue = ( uint64_t ) llValue;
+			if( iBytes < 8 )
+			{
+				ullValue &= ( 1ULL << ( 8 * iBytes ) ) - 1;
+				if( 0 != ( ullValue & ( 1ULL << ( 8 * iBytes - 1 ) ) ) )
+				{
+					llValue = ( int64_t ) ( ullValue | ~( ( 1ULL << ( 8 * iBytes ) ) - 1 ) );
+				}
+				else
+				{
+					llValue = ( int64_t ) ullValue;
+				}
+			}
+
+			if( 'c' == cConversion )
+			{
+				cSpec[ xSpec++ ] = 'c';
+				cSpec[ xSpec ] = '\0';
+				printf( cSpec, ( int ) llValue );
+			}
+			else if( 'p' == cConversion )
+			{
+				/* The pointer is sent as its value. */
+				cSpec[ xSpec++ ] = 'l';
+				cSpec[ xSpec++ ] = 'l';
+				cSpec[ xSpec++ ] = 'x';
+				cSpec[ xSpec ] = '\0';
+				fputs( "0x", stdout );
+				printf( cSpec, ( unsigned long long ) ( uint64_t ) llValue );
+			}
+			else
+			{
+				cSpec[ xSpec++ ] = 'l';
+				cSpec[ xSpec++ ] = 'l';
+				cSpec[ xSpec++ ] = cConversion;
+				cSpec[ xSpec ] = '\0';
+				if( 'd' == cConversion || 'i' == cConversion )
+				{
+					printf( cSpec, ( long long ) llValue );
+				}
+				else
+				{
+					printf( cSpec, ( unsigned long long ) ullValue );
+				}
+			}
+		}
+	}
+
+	return 1;
+}
+
+static int prvDecode( FILE *pxIn )
+{
+	char cLine[ 256 ];
+	size_t xLine = 0;
+	int iLongBytes = 0;		/* 0 while copying text. */
+	int iIntBytes = 0;
+	int c;
+
+	for( ; ; )
+	{
+		if( 0 == iLongBytes )
+		{
+			c = prvGetByte( pxIn );
+			if( EOF == c )
+			{
+				break;
+			}
+			if( xLine + 1 < sizeof( cLine ) )
+			{
+				cLine[ xLine++ ] = ( char ) c;
+			}
+			if( '\n' == c || sizeof( cLine ) - 1 == xLine )
+			{
+				cLine[ xLine ] = '\0';
+				if( 0 == strncmp( cLine, logHEADER, strlen( logHEADER ) ) )
+				{
+					const char *pcInt = strstr( cLine, " I" );
+
+					iLongBytes = atoi( cLine + strlen( logHEADER ) );
+					iIntBytes = ( NULL != pcInt ) ? atoi( pcInt + 2 ) : iLongBytes / 2;
+					if( ( 4 != iLongBytes && 8 != iLongBytes ) || ( 2 != iIntBytes && 4 != iIntBytes ) )
+					{
+						fprintf( stderr, "offset %lld: bad header %s", llOffset, cLine );
+						iLongBytes = 0;
+					}
+				}
+				else
+				{
+					fputs( cLine, stdout );
+				}
+				xLine = 0;
+			}
+			continue;
+		}
+
+		c = prvGetByte( pxIn );
+		if( EOF == c )
+		{
+			break;
+		}
+		if( logDROPPED_ID == c )
+		{
+			uint64_t ullDropped;
+
+			if( !prvGetVarint( pxIn, &ullDropped ) )
+			{
+				break;
+			}
+			printf( "LOG: %llu records dropped\n", ( unsigned long long ) ullDropped );
+		}
+		else if( c < iFormatCount )
+		{
+			if( !prvDecodeFrame( pxIn, c, iLongBytes, iIntBytes ) )
+			{
+				break;
+			}
+		}
+		else
+		{
+			/* Not a frame, e.g. text the sketch printed with Serial.print. */
+			fprintf( stderr, "offset %lld: unknown ID %d, copying text until the next header\n", llOffset - 1, c );
+			iLongBytes = 0;
+			cLine[ xLine++ ] = ( char ) c;
+		}
+	}
+
+	if( 0 != xLine )
+	{
+		fwrite( cLine, 1, xLine, stdout );
+	}
+
+	return 1;
+}
+
+static void prvUsage( const char *pcProgram )
+{
+	fprintf( stderr,
+			 "usage: %s -g log_table.h source...\n"
+			 "       %s log_table.h [capture]\n"
+			 "  -g  write the PRINTF formats of the sources to log_table.h\n"
+			 "      otherwise decode the capture (default stdin) with log_table.h\n",
+			 pcProgram, pcProgram );
+}
+
+int main( int argc, char **argv )
+{
+	FILE *pxIn = stdin;
+	int xResult;
+
+	if( argc >= 4 && 0 == strcmp( argv[ 1 ], "-g" ) )
+	{
+		return prvGenerate( argv[ 2 ], argc - 3, argv + 3 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	if( argc < 2 || argc > 3 || '-' == argv[ 1 ][ 0 ] )
+	{
+		prvUsage( argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	if( !prvLoadTable( argv[ 1 ] ) )
+	{
+		return EXIT_FAILURE;
+	}
+	if( 3 == argc )
+	{
+		pxIn = fopen( argv[ 2 ], "rb" );
+		if( NULL == pxIn )
+		{
+			perror( argv[ 2 ] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	xResult = prvDecode( pxIn );
+	if( stdin != pxIn )
+	{
+		fclose( pxIn );
+	}
+
+	return xResult ? EXIT_SUCCESS : EXIT_FAILURE;
+}
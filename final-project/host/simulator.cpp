@@ -0,0 +1,673 @@
+/* Discrete-event simulator for the RM, DM and EDF schedulers of
+ * ../src/src-RM-DM and ../src/src-EDF.
+ *
+ * Task sets use the same parameters as TaskProperties_t in ../main/main.h,
+ * one task per line:
+ *
+ *     <name> <phase> <WCET> <deadline> <period>
+ *
+ * Times are in ticks, or in milliseconds converted with pdMS_TO_TICKS when
+ * -m is given. '#' starts a comment.
+ *
+ * Priorities are replayed exactly as the target assigns them:
+ *  - RM/DM: prvSetFixedPriorities, i.e. tasks with the same period (deadline)
+ *    share a kernel priority and are time-sliced every tick.
+ *  - EDF: prvUpdatePrioritiesEDF, i.e. the tasks are kept sorted by absolute
+ *    deadline and a task whose deadline changes moves behind the tasks with
+ *    the same deadline.
+ *
+ * A job that has not finished by its absolute deadline is aborted and the task
+ * is released again in its next period, as prvDeadlineMissedHook does. With
+ * -k the job keeps running instead and is reported as late.
+ *
+ * Every job produces one record on stdout:
+ *
+ *     <name>,<job>,<release>,<start>,<finish>,<deadline>,<done|miss|late>
+ *
+ * <start> is -1 for a job that never ran. -q prints only the summary. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define simVIRTUAL_TICK_RATE_HZ		62		/* 15 ms watchdog tick of the ATmega port. */
+#define simMAX_NUMBER_OF_TASKS		64
+#define simMAX_TASK_NAME_LEN		8		/* configMAX_TASK_NAME_LEN */
+#define simSCHEDULER_PRIORITY		6		/* schedSCHEDULER_PRIORITY with configMAX_PRIORITIES 7 */
+#define simMAX_HORIZON				1000000000000ULL
+
+#define simPOLICY_RMS	1
+#define simPOLICY_DMS	2
+#define simPOLICY_EDF	3
+
+typedef struct SimTask
+{
+	char pcName[ simMAX_TASK_NAME_LEN ];
+	uint64_t ullPhase;				/* Release time of the first job. */
+	uint64_t ullMaxExecTime;		/* Worst-case execution time, every job runs for this long. */
+	uint64_t ullRelativeDeadline;
+	uint64_t ullPeriod;
+
+	int iPriority;					/* Kernel priority under RM/DM. */
+	int iEDFIndex;					/* Position in iEDFOrder under EDF. */
+	uint64_t ullReadyStamp;			/* Round-robin position among equal priorities. */
+
+	uint64_t ullJob;				/* Index of the oldest unfinished job. */
+	uint64_t ullReleased;			/* Number of jobs released so far. */
+	uint64_t ullRemaining;			/* Remaining execution time of job ullJob. */
+	int64_t llStart;				/* Start time of job ullJob, -1 if it has not run yet. */
+	int xLate;						/* Job ullJob has passed its deadline (-k only). */
+
+	uint64_t ullJobs;
+	uint64_t ullMisses;
+	uint64_t ullMaxResponse;
+	uint64_t ullSumResponse;
+} SimTask_t;
+
+static SimTask_t xTasks[ simMAX_NUMBER_OF_TASKS ];
+static int iTaskCount = 0;
+
+/* EDF: indices of xTasks sorted by absolute deadline, like pxEDFQueue. */
+static int iEDFOrder[ simMAX_NUMBER_OF_TASKS ];
+
+static int iPolicy = simPOLICY_RMS;
+static int xKeepLateJobs = 0;
+static int xQuiet = 0;
+
+static uint64_t ullReadySequence = 0;
+
+/*-----------------------------------------------------------*/
+/* Buffered record output. */
+
+static char cOutBuffer[ 1 << 16 ];
+static size_t xOutLength = 0;
+
+static void prvFlush( void )
+{
+	fwrite( cOutBuffer, 1, xOutLength, stdout );
+	xOutLength = 0;
+}
+
+static void prvPutChar( char c )
+{
+	cOutBuffer[ xOutLength++ ] = c;
+}
+
+static void prvPutString( const char *pc )
+{
+	while( '\0' != *pc )
+	{
+		prvPutChar( *pc++ );
+	}
+}
+
+static void prvPutInt( int64_t llValue )
+{
+	char cDigits[ 21 ];
+	int i = 0;
+	uint64_t ullValue;
+
+	if( llValue < 0 )
+	{
+		prvPutChar( '-' );
+		ullValue = ( uint64_t ) -llValue;
+	}
+	else
+	{
+		ullValue = ( uint64_t ) llValue;
+	}
+
+	do
+	{
+		cDigits[ i++ ] = ( char ) ( '0' + ullValue % 10 );
+		ullValue /= 10;
+	} while( 0 != ullValue );
+
+	while( i > 0 )
+	{
+		prvPutChar( cDigits[ --i ] );
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+static inline uint64_t prvReleaseTime( const SimTask_t *pxTask, uint64_t ullJob )
+{
+	return pxTask->ullPhase + ullJob * pxTask->ullPeriod;
+}
+
+static inline uint64_t prvAbsoluteDeadline( const SimTask_t *pxTask )
+{
+	return prvReleaseTime( pxTask, pxTask->ullJob ) + pxTask->ullRelativeDeadline;
+}
+
+static inline int prvIsActive( const SimTask_t *pxTask )
+{
+	return pxTask->ullJob < pxTask->ullReleased;
+}
+
+/* Same selection order as prvSetFixedPriorities: repeatedly pick the
+ * unassigned task with the shortest period (deadline), the last one on ties,
+ * and only step down a priority level when the key changes. */
+static void prvSetFixedPriorities( void )
+{
+	int xIsSet[ simMAX_NUMBER_OF_TASKS ] = { 0 };
+	int iHighestPriority = simSCHEDULER_PRIORITY;
+	uint64_t ullShortest, ullPreviousShortest = 0;
+	int iIter, iIndex, iShortest = 0;
+
+	for( iIter = 0; iIter < iTaskCount; iIter++ )
+	{
+		ullShortest = UINT64_MAX;
+
+		for( iIndex = 0; iIndex < iTaskCount; iIndex++ )
+		{
+			uint64_t ullKey = ( simPOLICY_RMS == iPolicy ) ? xTasks[ iIndex ].ullPeriod : xTasks[ iIndex ].ullRelativeDeadline;
+
+			if( !xIsSet[ iIndex ] && ullKey <= ullShortest )
+			{
+				ullShortest = ullKey;
+				iShortest = iIndex;
+			}
+		}
+
+		if( ullShortest != ullPreviousShortest )
+		{
+			iHighestPriority--;
+		}
+
+		xTasks[ iShortest ].iPriority = iHighestPriority;
+		xIsSet[ iShortest ] = 1;
+		ullPreviousShortest = ullShortest;
+	}
+
+	if( iHighestPriority <= 0 )
+	{
+		fprintf( stderr, "warning: more distinct priorities than the target has, prvSetFixedPriorities would trip configASSERT\n" );
+	}
+}
+
+/* Initial EDF order: stable insertion sort by absolute deadline, which is
+ * what inserting the tasks into pxEDFQueue in creation order amounts to. */
+static void prvInitEDFOrder( void )
+{
+	int i, j, iCurrent;
+	uint64_t ullDeadline;
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		iCurrent = i;
+		ullDeadline = prvAbsoluteDeadline( &xTasks[ iCurrent ] );
+
+		for( j = i; j > 0 && prvAbsoluteDeadline( &xTasks[ iEDFOrder[ j - 1 ] ] ) > ullDeadline; j-- )
+		{
+			iEDFOrder[ j ] = iEDFOrder[ j - 1 ];
+			xTasks[ iEDFOrder[ j ] ].iEDFIndex = j;
+		}
+		iEDFOrder[ j ] = iCurrent;
+		xTasks[ iCurrent ].iEDFIndex = j;
+	}
+}
+
+/* Deadlines only grow, so pxTask moves towards the tail, behind every task
+ * whose deadline is not later than its own. */
+static void prvUpdatePrioritiesEDF( SimTask_t *pxTask )
+{
+	int iTask = ( int ) ( pxTask - xTasks );
+	int i = pxTask->iEDFIndex;
+	uint64_t ullDeadline = prvAbsoluteDeadline( pxTask );
+
+	for( ; i + 1 < iTaskCount && prvAbsoluteDeadline( &xTasks[ iEDFOrder[ i + 1 ] ] ) <= ullDeadline; i++ )
+	{
+		iEDFOrder[ i ] = iEDFOrder[ i + 1 ];
+		xTasks[ iEDFOrder[ i ] ].iEDFIndex = i;
+	}
+	iEDFOrder[ i ] = iTask;
+	pxTask->iEDFIndex = i;
+}
+
+static SimTask_t *prvSelectTask( void )
+{
+	SimTask_t *pxSelected = NULL;
+	int i;
+
+	if( simPOLICY_EDF == iPolicy )
+	{
+		for( i = 0; i < iTaskCount; i++ )
+		{
+			if( prvIsActive( &xTasks[ iEDFOrder[ i ] ] ) )
+			{
+				return &xTasks[ iEDFOrder[ i ] ];
+			}
+		}
+		return NULL;
+	}
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		SimTask_t *pxTask = &xTasks[ i ];
+
+		if( prvIsActive( pxTask ) )
+		{
+			if( NULL == pxSelected || pxTask->iPriority > pxSelected->iPriority ||
+				( pxTask->iPriority == pxSelected->iPriority && pxTask->ullReadyStamp < pxSelected->ullReadyStamp ) )
+			{
+				pxSelected = pxTask;
+			}
+		}
+	}
+	return pxSelected;
+}
+
+/* pdTRUE when another ready task shares the kernel priority of pxRunning, in
+ * which case configUSE_TIME_SLICING switches to it on the next tick. */
+static int prvIsTimeSliced( const SimTask_t *pxRunning )
+{
+	int i;
+
+	if( simPOLICY_EDF == iPolicy )
+	{
+		return 0;
+	}
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		if( &xTasks[ i ] != pxRunning && prvIsActive( &xTasks[ i ] ) && xTasks[ i ].iPriority == pxRunning->iPriority )
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void prvRecordJob( SimTask_t *pxTask, uint64_t ullFinish, const char *pcStatus )
+{
+	uint64_t ullRelease = prvReleaseTime( pxTask, pxTask->ullJob );
+	uint64_t ullResponse = ullFinish - ullRelease;
+
+	pxTask->ullJobs++;
+	if( 'd' != pcStatus[ 0 ] )
+	{
+		pxTask->ullMisses++;
+	}
+	if( 'm' != pcStatus[ 0 ] )
+	{
+		pxTask->ullSumResponse += ullResponse;
+		if( ullResponse > pxTask->ullMaxResponse )
+		{
+			pxTask->ullMaxResponse = ullResponse;
+		}
+	}
+
+	if( !xQuiet )
+	{
+		if( xOutLength > sizeof( cOutBuffer ) - 160 )
+		{
+			prvFlush();
+		}
+		prvPutString( pxTask->pcName );
+		prvPutChar( ',' );
+		prvPutInt( ( int64_t ) pxTask->ullJob );
+		prvPutChar( ',' );
+		prvPutInt( ( int64_t ) ullRelease );
+		prvPutChar( ',' );
+		prvPutInt( pxTask->llStart );
+		prvPutChar( ',' );
+		prvPutInt( ( int64_t ) ullFinish );
+		prvPutChar( ',' );
+		prvPutInt( ( int64_t ) prvAbsoluteDeadline( pxTask ) );
+		prvPutChar( ',' );
+		prvPutString( pcStatus );
+		prvPutChar( '\n' );
+	}
+}
+
+/* Moves pxTask on to its next job. */
+static void prvNextJob( SimTask_t *pxTask )
+{
+	pxTask->ullJob++;
+	pxTask->ullRemaining = pxTask->ullMaxExecTime;
+	pxTask->llStart = -1;
+	pxTask->xLate = 0;
+
+	if( simPOLICY_EDF == iPolicy )
+	{
+		prvUpdatePrioritiesEDF( pxTask );
+	}
+}
+
+static uint64_t prvSimulate( uint64_t ullHorizon )
+{
+	uint64_t ullTime = 0, ullNext;
+	SimTask_t *pxRunning;
+	int i;
+
+	while( ullTime < ullHorizon )
+	{
+		/* Releases. */
+		for( i = 0; i < iTaskCount; i++ )
+		{
+			SimTask_t *pxTask = &xTasks[ i ];
+
+			while( prvReleaseTime( pxTask, pxTask->ullReleased ) <= ullTime )
+			{
+				if( !prvIsActive( pxTask ) )
+				{
+					pxTask->ullReadyStamp = ++ullReadySequence;
+				}
+				pxTask->ullReleased++;
+			}
+		}
+
+		/* Deadline misses. A job finishing exactly at its deadline meets it. */
+		for( i = 0; i < iTaskCount; i++ )
+		{
+			SimTask_t *pxTask = &xTasks[ i ];
+
+			while( prvIsActive( pxTask ) && !pxTask->xLate && prvAbsoluteDeadline( pxTask ) <= ullTime )
+			{
+				if( xKeepLateJobs )
+				{
+					pxTask->xLate = 1;
+				}
+				else
+				{
+					prvRecordJob( pxTask, ullTime, "miss" );
+					prvNextJob( pxTask );
+				}
+			}
+		}
+
+		pxRunning = prvSelectTask();
+
+		/* Next event: a release, a deadline, the running job's completion or
+		 * the next tick if the running task is time-sliced. */
+		ullNext = ullHorizon;
+		for( i = 0; i < iTaskCount; i++ )
+		{
+			SimTask_t *pxTask = &xTasks[ i ];
+			uint64_t ullRelease = prvReleaseTime( pxTask, pxTask->ullReleased );
+
+			if( ullRelease < ullNext )
+			{
+				ullNext = ullRelease;
+			}
+			if( prvIsActive( pxTask ) && !pxTask->xLate && prvAbsoluteDeadline( pxTask ) < ullNext )
+			{
+				ullNext = prvAbsoluteDeadline( pxTask );
+			}
+		}
+
+		if( NULL != pxRunning )
+		{
+			if( ullTime + pxRunning->ullRemaining < ullNext )
+			{
+				ullNext = ullTime + pxRunning->ullRemaining;
+			}
+			if( ullTime + 1 < ullNext && prvIsTimeSliced( pxRunning ) )
+			{
+				ullNext = ullTime + 1;
+			}
+
+			if( pxRunning->llStart < 0 )
+			{
+				pxRunning->llStart = ( int64_t ) ullTime;
+			}
+			pxRunning->ullRemaining -= ullNext - ullTime;
+
+			if( 0 == pxRunning->ullRemaining )
+			{
+				prvRecordJob( pxRunning, ullNext, pxRunning->xLate ? "late" : "done" );
+				prvNextJob( pxRunning );
+			}
+			else if( prvIsTimeSliced( pxRunning ) )
+			{
+				pxRunning->ullReadyStamp = ++ullReadySequence;
+			}
+		}
+
+		ullTime = ullNext;
+	}
+
+	return ullTime;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGCD( uint64_t a, uint64_t b )
+{
+	while( 0 != b )
+	{
+		uint64_t t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+/* Largest phase plus one hyperperiod, capped at simMAX_HORIZON. */
+static uint64_t prvDefaultHorizon( void )
+{
+	uint64_t ullHyperperiod = 1, ullMaxPhase = 0;
+	int i;
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		uint64_t ullPeriod = xTasks[ i ].ullPeriod;
+		uint64_t ullFactor = ullPeriod / prvGCD( ullHyperperiod, ullPeriod );
+
+		if( ullHyperperiod > simMAX_HORIZON / ullFactor )
+		{
+			return simMAX_HORIZON;
+		}
+		ullHyperperiod *= ullFactor;
+
+		if( xTasks[ i ].ullPhase > ullMaxPhase )
+		{
+			ullMaxPhase = xTasks[ i ].ullPhase;
+		}
+	}
+	return ullMaxPhase + ullHyperperiod;
+}
+
+/* pdMS_TO_TICKS with the 62 Hz watchdog tick. */
+static uint64_t prvMsToTicks( uint64_t ullMs )
+{
+	return ( ullMs * simVIRTUAL_TICK_RATE_HZ ) / 1000U;
+}
+
+static int prvLoadTaskSet( const char *pcPath, int xMilliseconds )
+{
+	FILE *pxFile = fopen( pcPath, "r" );
+	char cLine[ 256 ];
+	int iLine = 0;
+
+	if( NULL == pxFile )
+	{
+		perror( pcPath );
+		return 0;
+	}
+
+	iTaskCount = 0;
+	while( NULL != fgets( cLine, sizeof( cLine ), pxFile ) )
+	{
+		char cName[ 64 ];
+		unsigned long long ullPhase, ullWCET, ullDeadline, ullPeriod;
+		char *pcComment = strchr( cLine, '#' );
+		int iFields;
+
+		iLine++;
+		if( NULL != pcComment )
+		{
+			*pcComment = '\0';
+		}
+
+		iFields = sscanf( cLine, "%63s %llu %llu %llu %llu", cName, &ullPhase, &ullWCET, &ullDeadline, &ullPeriod );
+		if( iFields <= 0 )
+		{
+			continue;
+		}
+		if( 5 != iFields || iTaskCount == simMAX_NUMBER_OF_TASKS )
+		{
+			fprintf( stderr, "%s:%d: expected <name> <phase> <WCET> <deadline> <period>\n", pcPath, iLine );
+			fclose( pxFile );
+			return 0;
+		}
+
+		SimTask_t *pxTask = &xTasks[ iTaskCount ];
+		memset( pxTask, 0, sizeof( *pxTask ) );
+		snprintf( pxTask->pcName, sizeof( pxTask->pcName ), "%.*s", simMAX_TASK_NAME_LEN - 1, cName );
+		pxTask->ullPhase = xMilliseconds ? prvMsToTicks( ullPhase ) : ullPhase;
+		pxTask->ullMaxExecTime = xMilliseconds ? prvMsToTicks( ullWCET ) : ullWCET;
+		pxTask->ullRelativeDeadline = xMilliseconds ? prvMsToTicks( ullDeadline ) : ullDeadline;
+		pxTask->ullPeriod = xMilliseconds ? prvMsToTicks( ullPeriod ) : ullPeriod;
+
+		if( 0 == pxTask->ullPeriod || 0 == pxTask->ullMaxExecTime )
+		{
+			fprintf( stderr, "%s:%d: period and WCET must be at least one tick\n", pcPath, iLine );
+			fclose( pxFile );
+			return 0;
+		}
+
+		pxTask->ullRemaining = pxTask->ullMaxExecTime;
+		pxTask->llStart = -1;
+		iTaskCount++;
+	}
+
+	fclose( pxFile );
+	return iTaskCount > 0;
+}
+
+static void prvPrintSummary( const char *pcPath, uint64_t ullTicks, double dSeconds )
+{
+	FILE *pxOut = xQuiet ? stdout : stderr;
+	uint64_t ullJobs = 0, ullMisses = 0;
+	int i;
+
+	prvFlush();
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		ullJobs += xTasks[ i ].ullJobs;
+		ullMisses += xTasks[ i ].ullMisses;
+	}
+
+	fprintf( pxOut, "%s: %s, %llu ticks, %llu jobs, %llu misses\n", pcPath,
+			 ( simPOLICY_RMS == iPolicy ) ? "RM" : ( simPOLICY_DMS == iPolicy ) ? "DM" : "EDF",
+			 ( unsigned long long ) ullTicks, ( unsigned long long ) ullJobs, ( unsigned long long ) ullMisses );
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		SimTask_t *pxTask = &xTasks[ i ];
+		uint64_t ullCompleted = pxTask->ullJobs - ( xKeepLateJobs ? 0 : pxTask->ullMisses );
+
+		fprintf( pxOut, "  %-8s jobs %llu, misses %llu, max RT %llu, avg RT %.2f\n", pxTask->pcName,
+				 ( unsigned long long ) pxTask->ullJobs, ( unsigned long long ) pxTask->ullMisses,
+				 ( unsigned long long ) pxTask->ullMaxResponse,
+				 ullCompleted ? ( double ) pxTask->ullSumResponse / ( double ) ullCompleted : 0.0 );
+	}
+
+	fprintf( pxOut, "  %.3f s, %.2f M jobs/s\n", dSeconds, dSeconds > 0 ? ( double ) ullJobs / dSeconds / 1e6 : 0.0 );
+}
+
+static void prvUsage( const char *pcProgram )
+{
+	fprintf( stderr,
+			 "usage: %s [-p rm|dm|edf] [-t ticks] [-m] [-k] [-q] taskset...\n"
+			 "  -p  scheduling policy (default rm)\n"
+			 "  -t  simulated ticks (default: largest phase plus one hyperperiod)\n"
+			 "  -m  task set times are in milliseconds (pdMS_TO_TICKS at %d Hz)\n"
+			 "  -k  keep running jobs that missed their deadline instead of aborting them\n"
+			 "  -q  print only the summary\n",
+			 pcProgram, simVIRTUAL_TICK_RATE_HZ );
+}
+
+int main( int argc, char **argv )
+{
+	uint64_t ullHorizon = 0;
+	int xMilliseconds = 0;
+	int i;
+
+	for( i = 1; i < argc && '-' == argv[ i ][ 0 ]; i++ )
+	{
+		if( 0 == strcmp( argv[ i ], "-p" ) && i + 1 < argc )
+		{
+			i++;
+			if( 0 == strcmp( argv[ i ], "rm" ) )
+			{
+				iPolicy = simPOLICY_RMS;
+			}
+			else if( 0 == strcmp( argv[ i ], "dm" ) )
+			{
+				iPolicy = simPOLICY_DMS;
+			}
+			else if( 0 == strcmp( argv[ i ], "edf" ) )
+			{
+				iPolicy = simPOLICY_EDF;
+			}
+			else
+			{
+				prvUsage( argv[ 0 ] );
+				return EXIT_FAILURE;
+			}
+		}
+		else if( 0 == strcmp( argv[ i ], "-t" ) && i + 1 < argc )
+		{
+			ullHorizon = strtoull( argv[ ++i ], NULL, 0 );
+		}
+		else if( 0 == strcmp( argv[ i ], "-m" ) )
+		{
+			xMilliseconds = 1;
+		}
+		else if( 0 == strcmp( argv[ i ], "-k" ) )
+		{
+			xKeepLateJobs = 1;
+		}
+		else if( 0 == strcmp( argv[ i ], "-q" ) )
+		{
+			xQuiet = 1;
+		}
+		else
+		{
+			prvUsage( argv[ 0 ] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	if( i == argc )
+	{
+		prvUsage( argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+
+	for( ; i < argc; i++ )
+	{
+		struct timespec xStart, xEnd;
+		uint64_t ullTicks;
+
+		if( !prvLoadTaskSet( argv[ i ], xMilliseconds ) )
+		{
+			return EXIT_FAILURE;
+		}
+
+		if( simPOLICY_EDF != iPolicy )
+		{
+			prvSetFixedPriorities();
+		}
+		else
+		{
+			prvInitEDFOrder();
+		}
+
+		ullReadySequence = 0;
+		clock_gettime( CLOCK_MONOTONIC, &xStart );
+		ullTicks = prvSimulate( ullHorizon ? ullHorizon : prvDefaultHorizon() );
+		clock_gettime( CLOCK_MONOTONIC, &xEnd );
+
+		prvPrintSummary( argv[ i ], ullTicks,
+						 ( double ) ( xEnd.tv_sec - xStart.tv_sec ) + ( double ) ( xEnd.tv_nsec - xStart.tv_nsec ) / 1e9 );
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+/* Checks the Quick Processor-demand Analysis xSchedulerEDFFeasible() of
+ * ../../src/src-EDF on random synchronous task sets against the processor
+ * demand h( t ) <= t at every t up to the hyperperiod plus the longest
+ * deadline, which is exact for EDF. It also checks that the kernel's list
+ * code keeps the TCB list in insertion order, as the scheduler expects. */
+
+#include "scheduler.cpp"
+#include "test.h"
+
+#if( schedUSE_PROCESSOR_DEMAND_ANALYSIS == 1 )
+
+	#define testTASK_SETS		20000
+	#define testMAX_TASKS		6
+
+	/* All divide testHYPERPERIOD, so the brute force stays short. */
+	static const TickType_t xTestPeriods[] = { 4, 5, 6, 8, 10, 12, 15, 20, 24, 30, 40, 60 };
+	#define testHYPERPERIOD		120UL
+
+	static SchedTCB_t xTestTCBs[ testMAX_TASKS ];
+
+	/* xSchedulerEDFFeasible() walks the kernel's list, which must hold the
+	 * first xCount test TCBs in the order they were inserted. */
+	static void prvTestTCBList( BaseType_t xCount )
+	{
+		const ListItem_t *pxTCBListEndMarker = listGET_END_MARKER( pxTCBList );
+		ListItem_t *pxTCBListItem = listGET_HEAD_ENTRY( pxTCBList );
+		BaseType_t xIndex = 0;
+
+		testCHECK( listCURRENT_LIST_LENGTH( pxTCBList ) == ( UBaseType_t ) xCount );
+		while( pxTCBListItem != pxTCBListEndMarker && xIndex < xCount )
+		{
+			testCHECK( listGET_LIST_ITEM_OWNER( pxTCBListItem ) == &xTestTCBs[ xIndex ] );
+			testCHECK( listLIST_ITEM_CONTAINER( pxTCBListItem ) == pxTCBList );
+			pxTCBListItem = listGET_NEXT( pxTCBListItem );
+			xIndex++;
+		}
+		testCHECK( pxTCBListItem == pxTCBListEndMarker );
+		testCHECK( xIndex == xCount );
+	}
+
+	/* h( t ) <= t for every t in ( 0, H + Dmax ], and U <= 1. */
+	static BaseType_t prvTestFeasible( BaseType_t xCount )
+	{
+		uint32_t ulDemand = 0, ulDeadlineMax = 0, ulTime;
+		BaseType_t xIndex;
+
+		for( xIndex = 0; xIndex < xCount; xIndex++ )
+		{
+			ulDemand += xTestTCBs[ xIndex ].xMaxExecTime * ( testHYPERPERIOD / xTestTCBs[ xIndex ].xPeriod );
+			if( xTestTCBs[ xIndex ].xRelativeDeadline > ulDeadlineMax )
+			{
+				ulDeadlineMax = xTestTCBs[ xIndex ].xRelativeDeadline;
+			}
+		}
+		if( ulDemand > testHYPERPERIOD )
+		{
+			return pdFALSE;
+		}
+
+		for( ulTime = 1; ulTime <= testHYPERPERIOD + ulDeadlineMax; ulTime++ )
+		{
+			ulDemand = 0;
+			for( xIndex = 0; xIndex < xCount; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTestTCBs[ xIndex ];
+				if( ulTime >= pxTCB->xRelativeDeadline )
+				{
+					ulDemand += ( ( ulTime - pxTCB->xRelativeDeadline ) / pxTCB->xPeriod + 1 ) * pxTCB->xMaxExecTime;
+				}
+			}
+			if( ulDemand > ulTime )
+			{
+				return pdFALSE;
+			}
+		}
+
+		return pdTRUE;
+	}
+
+	static void prvTestQPA( void )
+	{
+		unsigned long ulFeasible = 0;
+		BaseType_t xSet, xIndex;
+
+		for( xSet = 0; xSet < testTASK_SETS; xSet++ )
+		{
+			BaseType_t xCount = ( BaseType_t ) ulTestRandom( 1, testMAX_TASKS );
+
+			prvInitTCBList();
+			for( xIndex = 0; xIndex < xCount; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTestTCBs[ xIndex ];
+				TickType_t xPeriod = xTestPeriods[ ulTestRandom( 0, sizeof( xTestPeriods ) / sizeof( xTestPeriods[ 0 ] ) - 1 ) ];
+
+				/* Around U = 1 in total, with deadlines up to twice the period. */
+				pxTCB->xPeriod = xPeriod;
+				pxTCB->xMaxExecTime = ulTestRandom( 1, ( 2 * xPeriod + xCount - 1 ) / xCount );
+				pxTCB->xRelativeDeadline = ulTestRandom( pxTCB->xMaxExecTime, 2 * xPeriod );
+
+				vListInitialiseItem( &pxTCB->xTCBListItem );
+				listSET_LIST_ITEM_OWNER( &pxTCB->xTCBListItem, pxTCB );
+				vListInsertEnd( pxTCBList, &pxTCB->xTCBListItem );
+			}
+
+			prvTestTCBList( xCount );
+
+			BaseType_t xExpected = prvTestFeasible( xCount );
+			testCHECK( xSchedulerEDFFeasible() == xExpected );
+			ulFeasible += ( pdTRUE == xExpected ) ? 1 : 0;
+
+			/* A deleted task leaves the others in order. */
+			testCHECK( uxListRemove( &xTestTCBs[ 0 ].xTCBListItem ) == ( UBaseType_t ) ( xCount - 1 ) );
+			testCHECK( ( 1 == xCount ) || ( listGET_LIST_ITEM_OWNER( listGET_HEAD_ENTRY( pxTCBList ) ) == &xTestTCBs[ 1 ] ) );
+		}
+
+		printf( "QPA: %d task sets, %lu feasible\n", testTASK_SETS, ulFeasible );
+	}
+
+#endif /* schedUSE_PROCESSOR_DEMAND_ANALYSIS */
+
+int main( void )
+{
+	#if( schedUSE_PROCESSOR_DEMAND_ANALYSIS == 1 )
+		prvTestQPA();
+	#endif /* schedUSE_PROCESSOR_DEMAND_ANALYSIS */
+
+	return iTestResult( "test-EDF" );
+}
@@ -0,0 +1,193 @@
+/* Checks the response-time analysis of ../../src/src-RM-DM on random task sets
+ * against a tick-by-tick schedule from the synchronous release, where each
+ * release also queues schedRTA_SCHEDULER_COST ticks of the scheduler task
+ * above all tasks. Keys (periods under RM, deadlines under DM) are distinct,
+ * so every task has its own priority and the critical instant is exact.
+ * With schedUSE_PRIORITY_BANDING it also checks prvBandFirstReady() against
+ * a scan of the ready ranks. */
+
+#include "scheduler.cpp"
+#include "test.h"
+
+/* Fills xTCBArray with xCount tasks of distinct keys and sets their priorities. */
+static void prvTestCreateTasks( BaseType_t xCount, TickType_t xLongestKey )
+{
+	BaseType_t xIndex, xOther;
+
+	xTaskCounter = xCount;
+	for( xIndex = 0; xIndex < xCount; xIndex++ )
+	{
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+		TickType_t xKey;
+		BaseType_t xUnique;
+
+		do
+		{
+			xKey = ulTestRandom( 4, xLongestKey );
+			xUnique = pdTRUE;
+			for( xOther = 0; xOther < xIndex; xOther++ )
+			{
+				#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
+					xUnique = ( xTCBArray[ xOther ].xPeriod == xKey ) ? pdFALSE : xUnique;
+				#else
+					xUnique = ( xTCBArray[ xOther ].xRelativeDeadline == xKey ) ? pdFALSE : xUnique;
+				#endif /* schedSCHEDULING_POLICY */
+			}
+		} while( pdFALSE == xUnique );
+
+		#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
+			pxTCB->xPeriod = xKey;
+			pxTCB->xMaxExecTime = ulTestRandom( 1, ( xKey + 1 ) / 2 );
+			pxTCB->xRelativeDeadline = ulTestRandom( pxTCB->xMaxExecTime, xKey );
+		#else
+			pxTCB->xRelativeDeadline = xKey;
+			pxTCB->xMaxExecTime = ulTestRandom( 1, ( xKey + 1 ) / 2 );
+			pxTCB->xPeriod = ulTestRandom( xKey, 2 * xKey );
+		#endif /* schedSCHEDULING_POLICY */
+		pxTCB->pcName = "T";
+		pxTCB->xInUse = pdTRUE;
+		pxTCB->xPriorityIsSet = pdFALSE;
+	}
+
+	prvSetFixedPriorities();
+}
+
+#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+
+	#define testTASK_SETS		20000
+	#define testMAX_TASKS		5
+
+	/* Response time of the first job of pxTCB in the synchronous schedule, or
+	 * ulLimit + 1 if it is longer than ulLimit. */
+	static uint32_t prvTestSimulate( SchedTCB_t *pxTCB, uint32_t ulLimit )
+	{
+		uint32_t ulBacklog[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { 0 };
+		uint32_t ulSchedulerBacklog = 0, ulDone = 0, ulTime;
+		BaseType_t xIndex;
+
+		for( ulTime = 0; ulTime <= ulLimit; ulTime++ )
+		{
+			BaseType_t xRun = -1;
+
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				if( 0 == ulTime % xTCBArray[ xIndex ].xPeriod )
+				{
+					ulBacklog[ xIndex ] += xTCBArray[ xIndex ].xMaxExecTime;
+					ulSchedulerBacklog += schedRTA_SCHEDULER_COST;
+				}
+			}
+
+			if( ulDone >= pxTCB->xMaxExecTime )
+			{
+				return ulTime;
+			}
+
+			if( ulSchedulerBacklog > 0 )
+			{
+				ulSchedulerBacklog--;
+				continue;
+			}
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				if( ( ulBacklog[ xIndex ] > 0 ) && ( ( xRun < 0 ) || ( xTCBArray[ xIndex ].uxPriority > xTCBArray[ xRun ].uxPriority ) ) )
+				{
+					xRun = xIndex;
+				}
+			}
+			if( xRun >= 0 )
+			{
+				ulBacklog[ xRun ]--;
+				ulDone += ( &xTCBArray[ xRun ] == pxTCB ) ? 1 : 0;
+			}
+		}
+
+		return ulLimit + 1;
+	}
+
+	static void prvTestResponseTime( void )
+	{
+		unsigned long ulFeasible = 0;
+		BaseType_t xSet, xIndex;
+
+		for( xSet = 0; xSet < testTASK_SETS; xSet++ )
+		{
+			BaseType_t xFeasible = pdTRUE;
+
+			prvTestCreateTasks( ( BaseType_t ) ulTestRandom( 1, testMAX_TASKS ), 40 );
+
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+				uint32_t ulLimit = ( pxTCB->xRelativeDeadline < pxTCB->xPeriod ) ? pxTCB->xRelativeDeadline : pxTCB->xPeriod;
+				uint32_t ulResponse = prvResponseTime( pxTCB, ulLimit );
+				uint32_t ulSimulated = prvTestSimulate( pxTCB, ulLimit );
+
+				if( ulResponse <= ulLimit )
+				{
+					testCHECK( ulSimulated == ulResponse );
+				}
+				else
+				{
+					testCHECK( ulSimulated > ulLimit );
+					xFeasible = pdFALSE;
+				}
+			}
+
+			testCHECK( prvResponseTimeAnalysis() == xFeasible );
+			ulFeasible += ( pdTRUE == xFeasible ) ? 1 : 0;
+		}
+
+		printf( "RTA: %d task sets, %lu feasible\n", testTASK_SETS, ulFeasible );
+	}
+
+#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+#if( schedUSE_PRIORITY_BANDING == 1 )
+
+	#define testBAND_STEPS		200000
+
+	static void prvTestBandReadySet( void )
+	{
+		BaseType_t xReady[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { 0 };
+		BaseType_t xStep, xRank;
+
+		prvTestCreateTasks( schedMAX_NUMBER_OF_PERIODIC_TASKS, 4 * schedMAX_NUMBER_OF_PERIODIC_TASKS );
+
+		/* The ranks follow the priorities, rank 0 the highest. */
+		for( xRank = 0; xRank < xTaskCounter; xRank++ )
+		{
+			testCHECK( pxBandRanked[ xRank ]->uxBandRank == ( UBaseType_t ) xRank );
+			testCHECK( ( 0 == xRank ) || ( pxBandRanked[ xRank ]->uxPriority < pxBandRanked[ xRank - 1 ]->uxPriority ) );
+		}
+
+		for( xStep = 0; xStep < testBAND_STEPS; xStep++ )
+		{
+			SchedTCB_t *pxExpected = NULL;
+
+			xRank = ( BaseType_t ) ulTestRandom( 0, xTaskCounter - 1 );
+			xReady[ xRank ] = ( pdTRUE == xReady[ xRank ] ) ? pdFALSE : pdTRUE;
+			prvBandMark( xRank, xReady[ xRank ] );
+
+			for( xRank = xTaskCounter - 1; xRank >= 0; xRank-- )
+			{
+				pxExpected = ( pdTRUE == xReady[ xRank ] ) ? pxBandRanked[ xRank ] : pxExpected;
+			}
+			testCHECK( prvBandFirstReady() == pxExpected );
+		}
+	}
+
+#endif /* schedUSE_PRIORITY_BANDING */
+
+int main( void )
+{
+	#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+		prvTestResponseTime();
+	#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+	#if( schedUSE_PRIORITY_BANDING == 1 )
+		prvTestBandReadySet();
+	#endif /* schedUSE_PRIORITY_BANDING */
+
+	return iTestResult( "test-RM-DM" );
+}
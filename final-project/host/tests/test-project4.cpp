@@ -0,0 +1,311 @@
+/* Checks of ../../../project-4/code/src, built with schedSCHEDULING_POLICY_OPA:
+ *  - Audsley's assignment prvSetOptimalPriorities() finds an order iff one of
+ *    all orders passes the response-time analysis, blocking included.
+ *  - prvSetFixedPriorities() keeps the deadline order when it has to share
+ *    priorities, and gives each deadline its own priority when there are
+ *    enough.
+ *  - prvTaskSetNext() against a scan of the set.
+ *  - The lock stack keeps the system ceiling and the held ceilings equal to
+ *    a scan of the locked resources, also when they are freed out of order. */
+
+#include "../../../project-4/code/src/scheduler.cpp"
+#include "test.h"
+
+#if( schedSCHEDULING_POLICY != schedSCHEDULING_POLICY_OPA )
+	#error "test-project4 needs schedSCHEDULING_POLICY_OPA"
+#endif
+
+#define testLEVELS		( ( BaseType_t ) ( schedSCHEDULER_PRIORITY - 1 - tskIDLE_PRIORITY ) )
+
+static TaskHandle_t xTestHandles[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+
+/* Fills xTCBArray with xCount tasks, deadlines in [ xShortest, xLongest ]. */
+static void prvTestCreateTasks( BaseType_t xCount, TickType_t xShortest, TickType_t xLongest )
+{
+	BaseType_t xIndex;
+
+	xTaskCounter = xCount;
+	for( xIndex = 0; xIndex < xCount; xIndex++ )
+	{
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+		pxTCB->xRelativeDeadline = ulTestRandom( xShortest, xLongest );
+		pxTCB->xMaxExecTime = ulTestRandom( 1, ( pxTCB->xRelativeDeadline + 2 ) / 3 );
+		pxTCB->xPeriod = ulTestRandom( pxTCB->xRelativeDeadline, 2 * pxTCB->xRelativeDeadline );
+		pxTCB->pcName = "T";
+		pxTCB->pxTaskHandle = &xTestHandles[ xIndex ];
+		pxTCB->xInUse = pdTRUE;
+		pxTCB->xPriorityIsSet = pdFALSE;
+		pxTCB->uxHeldCeiling = tskIDLE_PRIORITY;
+	}
+
+	xResourceCounter = 0;
+}
+
+/* pdTRUE if every task meets its deadline with the priorities set. */
+static BaseType_t prvTestOrderFeasible( void )
+{
+	BaseType_t xIndex;
+
+	for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+	{
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+		TickType_t xLimit = ( pxTCB->xRelativeDeadline < pxTCB->xPeriod ) ? pxTCB->xRelativeDeadline : pxTCB->xPeriod;
+
+		if( prvResponseTime( pxTCB, prvBlockingTime( pxTCB ), xLimit ) > xLimit )
+		{
+			return pdFALSE;
+		}
+	}
+
+	return pdTRUE;
+}
+
+/* pdTRUE if some order of the tasks not placed yet on the levels from
+ * uxLevel up passes, tried one by one. */
+static BaseType_t prvTestAnyOrderFeasible( UBaseType_t uxLevel )
+{
+	BaseType_t xIndex;
+
+	if( uxLevel > ( UBaseType_t ) xTaskCounter )
+	{
+		return prvTestOrderFeasible();
+	}
+
+	for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+	{
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+		if( pdFALSE == pxTCB->xPriorityIsSet )
+		{
+			BaseType_t xFeasible;
+
+			pxTCB->uxPriority = tskIDLE_PRIORITY + uxLevel;
+			pxTCB->xPriorityIsSet = pdTRUE;
+			xFeasible = prvTestAnyOrderFeasible( uxLevel + 1 );
+			pxTCB->xPriorityIsSet = pdFALSE;
+			if( pdTRUE == xFeasible )
+			{
+				return pdTRUE;
+			}
+		}
+	}
+
+	return pdFALSE;
+}
+
+#define testOPA_TASK_SETS	5000
+
+static void prvTestOptimalPriorities( void )
+{
+	unsigned long ulFeasible = 0;
+	BaseType_t xSet, xIndex, xOther;
+
+	for( xSet = 0; xSet < testOPA_TASK_SETS; xSet++ )
+	{
+		prvTestCreateTasks( ( BaseType_t ) ulTestRandom( 1, testLEVELS ), 4, 40 );
+
+		/* A few resources, each used by some of the tasks for at most their WCET. */
+		xResourceCounter = ( BaseType_t ) ulTestRandom( 0, schedMAX_NUMBER_OF_RESOURCES );
+		for( xIndex = 0; xIndex < xResourceCounter; xIndex++ )
+		{
+			SchedRCB_t *pxRCB = &xRCBArray[ xIndex ];
+
+			pxRCB->xUsedByTaskCounter = 0;
+			for( xOther = 0; xOther < xTaskCounter; xOther++ )
+			{
+				if( 0 == ulTestRandom( 0, 2 ) )
+				{
+					pxRCB->pxUsedByTask[ pxRCB->xUsedByTaskCounter ] = xTCBArray[ xOther ].pxTaskHandle;
+					pxRCB->xCriticalSectionTick[ pxRCB->xUsedByTaskCounter ] = ulTestRandom( 1, xTCBArray[ xOther ].xMaxExecTime );
+					pxRCB->xUsedByTaskCounter++;
+				}
+			}
+		}
+
+		BaseType_t xExpected = prvTestAnyOrderFeasible( 1 );
+		BaseType_t xFound = prvSetOptimalPriorities();
+
+		testCHECK( xFound == xExpected );
+		if( pdTRUE == xFound )
+		{
+			testCHECK( pdTRUE == prvTestOrderFeasible() );
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				testCHECK( xTCBArray[ xIndex ].uxPriority > tskIDLE_PRIORITY && xTCBArray[ xIndex ].uxPriority < schedSCHEDULER_PRIORITY );
+				for( xOther = 0; xOther < xIndex; xOther++ )
+				{
+					testCHECK( xTCBArray[ xIndex ].uxPriority != xTCBArray[ xOther ].uxPriority );
+				}
+			}
+			ulFeasible++;
+		}
+	}
+
+	printf( "OPA: %d task sets, %lu feasible\n", testOPA_TASK_SETS, ulFeasible );
+}
+
+#define testMAPPING_TASK_SETS	2000
+
+/* More tasks than levels, so Audsley's assignment gives up and the tasks are
+ * ordered by deadline. With more deadlines than levels, each level takes at
+ * most one deadline more than another. */
+static void prvTestFixedPriorities( void )
+{
+	BaseType_t xSet, xIndex, xOther;
+
+	for( xSet = 0; xSet < testMAPPING_TASK_SETS; xSet++ )
+	{
+		BaseType_t xGroups = 0, xPriorities = 0;
+		BaseType_t xGroupsAt[ configMAX_PRIORITIES ] = { 0 };
+
+		prvTestCreateTasks( ( BaseType_t ) ulTestRandom( testLEVELS + 1, schedMAX_NUMBER_OF_PERIODIC_TASKS ), 4, ulTestRandom( 4, 100 ) );
+		prvSetFixedPriorities();
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			BaseType_t xNewDeadline = pdTRUE, xNewPriority = pdTRUE;
+
+			testCHECK( pxTCB->uxPriority > tskIDLE_PRIORITY && pxTCB->uxPriority < schedSCHEDULER_PRIORITY );
+			testCHECK( pxTCB->uxActivePriority == pxTCB->uxPriority );
+
+			for( xOther = 0; xOther < xIndex; xOther++ )
+			{
+				SchedTCB_t *pxOther = &xTCBArray[ xOther ];
+
+				if( pxOther->xRelativeDeadline < pxTCB->xRelativeDeadline )
+				{
+					testCHECK( pxOther->uxPriority >= pxTCB->uxPriority );
+				}
+				else if( pxOther->xRelativeDeadline > pxTCB->xRelativeDeadline )
+				{
+					testCHECK( pxOther->uxPriority <= pxTCB->uxPriority );
+				}
+				else
+				{
+					testCHECK( pxOther->uxPriority == pxTCB->uxPriority );
+				}
+				xNewDeadline = ( pxOther->xRelativeDeadline == pxTCB->xRelativeDeadline ) ? pdFALSE : xNewDeadline;
+				xNewPriority = ( pxOther->uxPriority == pxTCB->uxPriority ) ? pdFALSE : xNewPriority;
+			}
+			xGroups += xNewDeadline;
+			xPriorities += xNewPriority;
+			xGroupsAt[ pxTCB->uxPriority ] += xNewDeadline;
+		}
+
+		testCHECK( xPriorities == ( ( xGroups < testLEVELS ) ? xGroups : testLEVELS ) );
+		for( xIndex = 0; xIndex < configMAX_PRIORITIES; xIndex++ )
+		{
+			testCHECK( xGroupsAt[ xIndex ] <= ( xGroups + testLEVELS - 1 ) / testLEVELS );
+		}
+	}
+
+	printf( "Fixed priorities: %d task sets\n", testMAPPING_TASK_SETS );
+}
+
+#define testTASK_SET_STEPS		200000
+
+static void prvTestTaskSet( void )
+{
+	SchedTaskSet_t xSet = { { 0 } };
+	BaseType_t xMember[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { 0 };
+	BaseType_t xStep;
+
+	for( xStep = 0; xStep < testTASK_SET_STEPS; xStep++ )
+	{
+		UBaseType_t uxIndex = ulTestRandom( 0, schedMAX_NUMBER_OF_PERIODIC_TASKS - 1 );
+		UBaseType_t uxFrom = ulTestRandom( 0, schedMAX_NUMBER_OF_PERIODIC_TASKS );
+		UBaseType_t uxExpected;
+
+		if( pdTRUE == xMember[ uxIndex ] )
+		{
+			prvTaskSetRemove( &xSet, uxIndex );
+			xMember[ uxIndex ] = pdFALSE;
+		}
+		else
+		{
+			prvTaskSetAdd( &xSet, uxIndex );
+			xMember[ uxIndex ] = pdTRUE;
+		}
+
+		for( uxExpected = uxFrom; uxExpected < schedMAX_NUMBER_OF_PERIODIC_TASKS && pdFALSE == xMember[ uxExpected ]; uxExpected++ )
+		{
+		}
+		testCHECK( prvTaskSetNext( &xSet, uxFrom ) == uxExpected );
+	}
+
+	printf( "Task sets: %d steps\n", testTASK_SET_STEPS );
+}
+
+#define testLOCK_STEPS		200000
+#define testLOCK_TASKS		4
+
+static void prvTestLockStack( void )
+{
+	BaseType_t xStep, xIndex;
+
+	prvTestCreateTasks( testLOCK_TASKS, 4, 40 );
+	for( xIndex = 0; xIndex < schedMAX_NUMBER_OF_RESOURCES; xIndex++ )
+	{
+		xRCBArray[ xIndex ].uxPriorityCeiling = ulTestRandom( tskIDLE_PRIORITY + 1, schedSCHEDULER_PRIORITY - 1 );
+		xRCBArray[ xIndex ].xIsLocked = pdFALSE;
+	}
+
+	for( xStep = 0; xStep < testLOCK_STEPS; xStep++ )
+	{
+		SchedRCB_t *pxRCB = &xRCBArray[ ulTestRandom( 0, schedMAX_NUMBER_OF_RESOURCES - 1 ) ];
+		UBaseType_t uxCeiling = tskIDLE_PRIORITY;
+
+		/* Any locked resource may be freed, not only the last one locked. */
+		if( pdFALSE == pxRCB->xIsLocked )
+		{
+			pxRCB->xIsLocked = pdTRUE;
+			pxRCB->pxHolderTCB = &xTCBArray[ ulTestRandom( 0, testLOCK_TASKS - 1 ) ];
+			prvPushLock( pxRCB );
+		}
+		else
+		{
+			prvPopLock( pxRCB );
+			pxRCB->xIsLocked = pdFALSE;
+			pxRCB->pxHolderTCB = NULL;
+		}
+
+		for( xIndex = 0; xIndex < schedMAX_NUMBER_OF_RESOURCES; xIndex++ )
+		{
+			if( ( pdTRUE == xRCBArray[ xIndex ].xIsLocked ) && ( xRCBArray[ xIndex ].uxPriorityCeiling > uxCeiling ) )
+			{
+				uxCeiling = xRCBArray[ xIndex ].uxPriorityCeiling;
+			}
+		}
+		testCHECK( uxSystemPriorityCeiling == uxCeiling );
+		testCHECK( ( tskIDLE_PRIORITY == uxCeiling ) || ( NULL != pxSystemPriorityCeilingPointer && pdTRUE == pxSystemPriorityCeilingPointer->xIsLocked && pxSystemPriorityCeilingPointer->uxPriorityCeiling == uxCeiling ) );
+
+		for( xIndex = 0; xIndex < testLOCK_TASKS; xIndex++ )
+		{
+			BaseType_t xResource;
+
+			uxCeiling = tskIDLE_PRIORITY;
+			for( xResource = 0; xResource < schedMAX_NUMBER_OF_RESOURCES; xResource++ )
+			{
+				SchedRCB_t *pxLocked = &xRCBArray[ xResource ];
+				if( ( pdTRUE == pxLocked->xIsLocked ) && ( &xTCBArray[ xIndex ] == pxLocked->pxHolderTCB ) && ( pxLocked->uxPriorityCeiling > uxCeiling ) )
+				{
+					uxCeiling = pxLocked->uxPriorityCeiling;
+				}
+			}
+			testCHECK( xTCBArray[ xIndex ].uxHeldCeiling == uxCeiling );
+		}
+	}
+
+	printf( "Lock stack: %d steps\n", testLOCK_STEPS );
+}
+
+int main( void )
+{
+	prvTestOptimalPriorities();
+	prvTestFixedPriorities();
+	prvTestTaskSet();
+	prvTestLockStack();
+
+	return iTestResult( "test-project4" );
+}
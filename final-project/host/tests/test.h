@@ -0,0 +1,56 @@
+#ifndef TEST_H
+#define TEST_H
+
+/* Helpers of the host tests, see "make test" in ../Makefile. Each test
+ * includes the scheduler.cpp it checks, so it can call its static functions
+ * and fill its TCBs directly. The kernel is linked but never started, and
+ * PRINTF is off (DEBUG 0). A failed configASSERT ends the test with
+ * vHostAssertCalled(). */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static unsigned long ulTestChecks = 0;
+static unsigned long ulTestFailures = 0;
+
+/* Counts a check, and prints it if it failed and is one of the first few
+ * that did. */
+static void vTestCheck( int iPassed, const char *pcFile, int iLine, const char *pcCheck )
+{
+	ulTestChecks++;
+	if( !iPassed && ulTestFailures++ < 10 )
+	{
+		printf( "FAIL: %s:%d: %s\n", pcFile, iLine, pcCheck );
+	}
+}
+
+#define testCHECK( x )    vTestCheck( ( x ) ? 1 : 0, __FILE__, __LINE__, #x )
+
+/* xorshift32, fixed seed, so a failure can be reproduced. */
+static uint32_t ulTestSeed = 0x2545F491UL;
+
+/* Returns a pseudo-random number in [ ulLow, ulHigh ]. */
+static uint32_t ulTestRandom( uint32_t ulLow, uint32_t ulHigh )
+{
+	ulTestSeed ^= ulTestSeed << 13;
+	ulTestSeed ^= ulTestSeed >> 17;
+	ulTestSeed ^= ulTestSeed << 5;
+
+	return ulLow + ulTestSeed % ( ulHigh - ulLow + 1 );
+}
+
+/* Prints the result line of pcName and returns the exit status of the test. */
+static int iTestResult( const char *pcName )
+{
+	printf( "%s: %lu checks, %lu failed\n", pcName, ulTestChecks, ulTestFailures );
+
+	return ( 0 == ulTestFailures ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* host.cpp runs the sketch's loop() from the idle hook, which never runs here. */
+void loop( void )
+{
+}
+
+#endif /* TEST_H */
@@ -0,0 +1,670 @@
+/* Reads a serial log of the scheduler variants (text, or the output of
+ * logtoken for schedLOG_TOKENIZED captures) and reports per task:
+ *
+ *  - jobs, from the STAT lines printed at the end of every job,
+ *  - deadline misses and WCET overruns, from prvDeadlineMissedHook and
+ *    prvExecTimeExceedHook,
+ *  - the span of a job (ET - ST) and its lateness (ET - DT), with min, max,
+ *    mean and jitter (max - min),
+ *  - with -s, the response time ET - release and the start latency
+ *    ST - release, where release = DT - the task's relative deadline,
+ *  - blocking on resources (project-4), from the Blocked and Unblocked lines.
+ *
+ * With -o the jobs, resource holds, blocking and misses are also written as
+ * a Chrome trace (chrome://tracing, ui.perfetto.dev), one lane per task and
+ * per resource. A job is drawn from its start to its end tick, preemptions
+ * within it are not in the log.
+ *
+ * The log is read in a single pass, memory does not grow with its length.
+ * Ticks are unwrapped from -w bits (16 on the ATmega, 32 on the host build),
+ * so captures of many hours are fine as long as consecutive events are less
+ * than half the tick range apart. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define traceMAX_NUMBER_OF_TASKS		64
+#define traceMAX_NUMBER_OF_RESOURCES	16
+#define traceMAX_NAME_LEN				16
+#define traceRESOURCE_TID				1000	/* Chrome trace lanes of the resources start here. */
+
+/* Running min, max, mean and variance of a series, in constant space. */
+typedef struct TraceStat
+{
+	uint64_t ullCount;
+	int64_t llMin;
+	int64_t llMax;
+	double dMean;
+	double dM2;
+} TraceStat_t;
+
+typedef struct TraceTask
+{
+	char pcName[ traceMAX_NAME_LEN ];
+	int64_t llRelativeDeadline;		/* From -s, -1 if unknown. */
+
+	uint64_t ullMisses;
+	uint64_t ullOverruns;
+	uint64_t ullLate;				/* Jobs that ended after their deadline. */
+	TraceStat_t xSpan;
+	TraceStat_t xLateness;
+	TraceStat_t xResponse;
+	TraceStat_t xStartLatency;
+
+	uint64_t ullBlocked;
+	uint64_t ullBlockedTicks;
+	int64_t llMaxBlocked;
+	int64_t llBlockedSince;			/* -1 if not blocked. */
+	char pcBlocker[ traceMAX_NAME_LEN ];
+} TraceTask_t;
+
+typedef struct TraceResource
+{
+	char pcName[ traceMAX_NAME_LEN ];
+	char pcHolder[ traceMAX_NAME_LEN ];
+	int64_t llLockedSince;			/* -1 if free. */
+	uint64_t ullLocks;
+} TraceResource_t;
+
+static TraceTask_t xTasks[ traceMAX_NUMBER_OF_TASKS ];
+static int iTaskCount = 0;
+static TraceResource_t xResources[ traceMAX_NUMBER_OF_RESOURCES ];
+static int iResourceCount = 0;
+
+static int iTickBits = 16;
+static double dTickRate = 62.0;		/* 15 ms watchdog tick, hostVIRTUAL_TICK_RATE_HZ. */
+static FILE *pxTrace = NULL;
+static int xFirstEvent = 1;
+
+/* Unwrapped tick of the latest event, -1 before the first one. */
+static int64_t llTickReference = -1;
+
+/*-----------------------------------------------------------*/
+
+static void prvStatAdd( TraceStat_t *pxStat, int64_t llValue )
+{
+	double dDelta;
+
+	if( 0 == pxStat->ullCount || llValue < pxStat->llMin )
+	{
+		pxStat->llMin = llValue;
+	}
+	if( 0 == pxStat->ullCount || llValue > pxStat->llMax )
+	{
+		pxStat->llMax = llValue;
+	}
+	pxStat->ullCount++;
+	dDelta = ( double ) llValue - pxStat->dMean;
+	pxStat->dMean += dDelta / ( double ) pxStat->ullCount;
+	pxStat->dM2 += dDelta * ( ( double ) llValue - pxStat->dMean );
+}
+
+/* Turns a tick printed with iTickBits bits into a tick that does not wrap,
+ * the one closest to the latest event. */
+static int64_t prvUnwrap( uint64_t ullTick )
+{
+	uint64_t ullMask = ( iTickBits >= 64 ) ? ~0ULL : ( ( 1ULL << iTickBits ) - 1 );
+	int64_t llTick;
+
+	ullTick &= ullMask;
+	if( llTickReference < 0 )
+	{
+		llTick = ( int64_t ) ullTick;
+	}
+	else
+	{
+		uint64_t ullDelta = ( ullTick - ( uint64_t ) llTickReference ) & ullMask;
+		int64_t llDelta = ( int64_t ) ullDelta;
+
+		if( ullDelta > ( ullMask >> 1 ) )
+		{
+			llDelta -= ( int64_t ) ullMask + 1;
+		}
+		llTick = llTickReference + llDelta;
+	}
+
+	if( llTick > llTickReference )
+	{
+		llTickReference = llTick;
+	}
+
+	return llTick;
+}
+
+static TraceTask_t *prvGetTask( const char *pcName )
+{
+	for( int i = 0; i < iTaskCount; i++ )
+	{
+		if( 0 == strcmp( xTasks[ i ].pcName, pcName ) )
+		{
+			return &xTasks[ i ];
+		}
+	}
+	if( traceMAX_NUMBER_OF_TASKS == iTaskCount )
+	{
+		return NULL;
+	}
+
+	TraceTask_t *pxTask = &xTasks[ iTaskCount++ ];
+	memset( pxTask, 0, sizeof( *pxTask ) );
+	snprintf( pxTask->pcName, sizeof( pxTask->pcName ), "%s", pcName );
+	pxTask->llRelativeDeadline = -1;
+	pxTask->llBlockedSince = -1;
+
+	return pxTask;
+}
+
+static TraceResource_t *prvGetResource( const char *pcName )
+{
+	for( int i = 0; i < iResourceCount; i++ )
+	{
+		if( 0 == strcmp( xResources[ i ].pcName, pcName ) )
+		{
+			return &xResources[ i ];
+		}
+	}
+	if( traceMAX_NUMBER_OF_RESOURCES == iResourceCount )
+	{
+		return NULL;
+	}
+
+	TraceResource_t *pxResource = &xResources[ iResourceCount++ ];
+	memset( pxResource, 0, sizeof( *pxResource ) );
+	snprintf( pxResource->pcName, sizeof( pxResource->pcName ), "%s", pcName );
+	pxResource->llLockedSince = -1;
+
+	return pxResource;
+}
+
+/*-----------------------------------------------------------*/
+/* Chrome trace output, written as the events are read. */
+
+static double prvTickToMicroseconds( int64_t llTick )
+{
+	return ( double ) llTick * 1e6 / dTickRate;
+}
+
+static void prvTraceBegin( void )
+{
+	if( xFirstEvent )
+	{
+		fputs( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", pxTrace );
+		xFirstEvent = 0;
+	}
+	else
+	{
+		fputs( ",\n", pxTrace );
+	}
+}
+
+static void prvTraceLane( int iTid, const char *pcName )
+{
+	if( NULL != pxTrace )
+	{
+		prvTraceBegin();
+		fprintf( pxTrace, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", iTid, pcName );
+	}
+}
+
+static void prvTraceSpan( int iTid, const char *pcName, int64_t llStart, int64_t llEnd, const char *pcArgs )
+{
+	if( NULL != pxTrace )
+	{
+		prvTraceBegin();
+		fprintf( pxTrace, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.0f,\"dur\":%.0f,\"args\":{%s}}",
+				 pcName, iTid, prvTickToMicroseconds( llStart ), prvTickToMicroseconds( llEnd - llStart ), pcArgs );
+	}
+}
+
+static void prvTraceInstant( int iTid, const char *pcName, int64_t llTick )
+{
+	if( NULL != pxTrace )
+	{
+		prvTraceBegin();
+		fprintf( pxTrace, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.0f}",
+				 pcName, iTid, prvTickToMicroseconds( llTick ) );
+	}
+}
+
+static int prvTaskTid( const TraceTask_t *pxTask )
+{
+	return ( int ) ( pxTask - xTasks ) + 1;
+}
+
+static TraceTask_t *prvSeeTask( const char *pcName )
+{
+	int iCount = iTaskCount;
+	TraceTask_t *pxTask = prvGetTask( pcName );
+
+	if( NULL != pxTask && iCount != iTaskCount )
+	{
+		prvTraceLane( prvTaskTid( pxTask ), pcName );
+	}
+
+	return pxTask;
+}
+
+static TraceResource_t *prvSeeResource( const char *pcName )
+{
+	int iCount = iResourceCount;
+	TraceResource_t *pxResource = prvGetResource( pcName );
+
+	if( NULL != pxResource && iCount != iResourceCount )
+	{
+		prvTraceLane( traceRESOURCE_TID + ( int ) ( pxResource - xResources ), pcName );
+	}
+
+	return pxResource;
+}
+
+/*-----------------------------------------------------------*/
+/* Line parsing. */
+
+/* Copies the word that ends right before pcAt into pcWord. */
+static void prvWordBefore( const char *pcLine, const char *pcAt, char *pcWord )
+{
+	const char *pcEnd = pcAt;
+	const char *pcStart;
+
+	while( pcEnd > pcLine && ' ' == pcEnd[ -1 ] )
+	{
+		pcEnd--;
+	}
+	pcStart = pcEnd;
+	while( pcStart > pcLine && ' ' != pcStart[ -1 ] && '|' != pcStart[ -1 ] )
+	{
+		pcStart--;
+	}
+	snprintf( pcWord, traceMAX_NAME_LEN, "%.*s", ( int ) ( pcEnd - pcStart ), pcStart );
+}
+
+/* Copies the word that starts at pc (after spaces) into pcWord. */
+static void prvWordAt( const char *pc, char *pcWord )
+{
+	size_t xLength = 0;
+
+	while( ' ' == *pc )
+	{
+		pc++;
+	}
+	while( '\0' != pc[ xLength ] && ' ' != pc[ xLength ] && ',' != pc[ xLength ] && '\n' != pc[ xLength ] && '\r' != pc[ xLength ] )
+	{
+		xLength++;
+	}
+	snprintf( pcWord, traceMAX_NAME_LEN, "%.*s", ( int ) xLength, pc );
+}
+
+/* Tick of the "T : n" at the end of an event, or the latest tick. */
+static int64_t prvEventTick( const char *pcFrom )
+{
+	const char *pc = strstr( pcFrom, "T : " );
+
+	if( NULL != pc )
+	{
+		return prvUnwrap( strtoull( pc + 4, NULL, 10 ) );
+	}
+
+	return llTickReference < 0 ? 0 : llTickReference;
+}
+
+static void prvParseStat( const char *pcLine )
+{
+	char cName[ traceMAX_NAME_LEN ];
+	unsigned long long ullStart, ullEnd, ullRun, ullDeadline;
+	char cArgs[ 128 ];
+
+	if( 5 != sscanf( pcLine, "STAT: %15[^, ] , ST:%llu, ET:%llu, RT:%llu, DT: %llu", cName, &ullStart, &ullEnd, &ullRun, &ullDeadline ) )
+	{
+		return;
+	}
+
+	TraceTask_t *pxTask = prvSeeTask( cName );
+	if( NULL == pxTask )
+	{
+		return;
+	}
+
+	/* The end is printed last, unwrap it first so that the others are close to it. */
+	int64_t llEnd = prvUnwrap( ullEnd );
+	int64_t llStart = prvUnwrap( ullStart );
+	int64_t llDeadline = prvUnwrap( ullDeadline );
+
+	prvStatAdd( &pxTask->xSpan, llEnd - llStart );
+	prvStatAdd( &pxTask->xLateness, llEnd - llDeadline );
+	if( llEnd > llDeadline )
+	{
+		pxTask->ullLate++;
+	}
+	if( pxTask->llRelativeDeadline >= 0 )
+	{
+		int64_t llRelease = llDeadline - pxTask->llRelativeDeadline;
+		prvStatAdd( &pxTask->xResponse, llEnd - llRelease );
+		prvStatAdd( &pxTask->xStartLatency, llStart - llRelease );
+	}
+
+	snprintf( cArgs, sizeof( cArgs ), "\"start\":%lld,\"end\":%lld,\"deadline\":%lld", ( long long ) llStart, ( long long ) llEnd, ( long long ) llDeadline );
+	prvTraceSpan( prvTaskTid( pxTask ), pxTask->pcName, llStart, llEnd, cArgs );
+}
+
+/* " -> TASK: T1, T : 12" or " -> TASK: T1 @ T : 12" after a hook's FUNC line. */
+static void prvParseHook( const char *pcLine, const char *pcHook )
+{
+	const char *pc = strstr( pcLine, "TASK: " );
+	char cName[ traceMAX_NAME_LEN ];
+
+	if( NULL == pc )
+	{
+		return;
+	}
+	prvWordAt( pc + 6, cName );
+
+	TraceTask_t *pxTask = prvSeeTask( cName );
+	if( NULL == pxTask )
+	{
+		return;
+	}
+
+	int64_t llTick = prvEventTick( pc );
+	if( 0 == strcmp( pcHook, "miss" ) )
+	{
+		pxTask->ullMisses++;
+	}
+	else
+	{
+		pxTask->ullOverruns++;
+	}
+	prvTraceInstant( prvTaskTid( pxTask ), pcHook, llTick );
+}
+
+static void prvParseResources( const char *pcLine )
+{
+	const char *pc;
+	char cFirst[ traceMAX_NAME_LEN ];
+	char cSecond[ traceMAX_NAME_LEN ];
+
+	/* "R1 Locked By T1 | SPC : 2 @ T : 12", "R1 Locked By T1 @ T : 12", "R1 Locked By T1" */
+	if( NULL != ( pc = strstr( pcLine, " Locked By " ) ) )
+	{
+		prvWordBefore( pcLine, pc, cFirst );
+		prvWordAt( pc + 11, cSecond );
+		TraceResource_t *pxResource = prvSeeResource( cFirst );
+		if( NULL != pxResource )
+		{
+			pxResource->llLockedSince = prvEventTick( pc );
+			pxResource->ullLocks++;
+			snprintf( pxResource->pcHolder, sizeof( pxResource->pcHolder ), "%s", cSecond );
+		}
+	}
+
+	/* "R1 Freed By T1 @ T : 20" */
+	if( NULL != ( pc = strstr( pcLine, " Freed By " ) ) )
+	{
+		prvWordBefore( pcLine, pc, cFirst );
+		TraceResource_t *pxResource = prvSeeResource( cFirst );
+		int64_t llTick = prvEventTick( pc );
+		if( NULL != pxResource && pxResource->llLockedSince >= 0 )
+		{
+			prvTraceSpan( traceRESOURCE_TID + ( int ) ( pxResource - xResources ), pxResource->pcHolder, pxResource->llLockedSince, llTick, "" );
+			pxResource->llLockedSince = -1;
+		}
+	}
+
+	/* "R1 Denied To T2 | T2 Blocked T1 @ T : 12", the first name is blocked by the second. */
+	if( NULL != ( pc = strstr( pcLine, " Blocked " ) ) && ( pc - pcLine < 2 || 0 != strncmp( pc - 2, "Un", 2 ) ) )
+	{
+		prvWordBefore( pcLine, pc, cFirst );
+		prvWordAt( pc + 9, cSecond );
+		TraceTask_t *pxTask = prvSeeTask( cFirst );
+		if( NULL != pxTask )
+		{
+			pxTask->llBlockedSince = prvEventTick( pc );
+			pxTask->ullBlocked++;
+			snprintf( pxTask->pcBlocker, sizeof( pxTask->pcBlocker ), "%s", cSecond );
+		}
+	}
+
+	/* "T2 Unblocked T1 @ T : 20" */
+	if( NULL != ( pc = strstr( pcLine, " Unblocked " ) ) )
+	{
+		prvWordBefore( pcLine, pc, cFirst );
+		TraceTask_t *pxTask = prvSeeTask( cFirst );
+		int64_t llTick = prvEventTick( pc );
+		if( NULL != pxTask && pxTask->llBlockedSince >= 0 )
+		{
+			char cName[ 2 * traceMAX_NAME_LEN ];
+			int64_t llBlocked = llTick - pxTask->llBlockedSince;
+
+			pxTask->ullBlockedTicks += ( uint64_t ) llBlocked;
+			if( llBlocked > pxTask->llMaxBlocked )
+			{
+				pxTask->llMaxBlocked = llBlocked;
+			}
+			snprintf( cName, sizeof( cName ), "blocked by %s", pxTask->pcBlocker );
+			prvTraceSpan( prvTaskTid( pxTask ), cName, pxTask->llBlockedSince, llTick, "" );
+			pxTask->llBlockedSince = -1;
+		}
+	}
+}
+
+static void prvParseLine( const char *pcLine )
+{
+	if( 0 == strncmp( pcLine, "STAT: ", 6 ) )
+	{
+		prvParseStat( pcLine );
+	}
+	else if( NULL != strstr( pcLine, "prvDeadlineMissedHook" ) )
+	{
+		prvParseHook( pcLine, "miss" );
+	}
+	else if( NULL != strstr( pcLine, "prvExecTimeExceedHook" ) )
+	{
+		prvParseHook( pcLine, "overrun" );
+	}
+	else
+	{
+		prvParseResources( pcLine );
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+static uint64_t prvMsToTicks( uint64_t ullMs )
+{
+	return ( uint64_t ) ( ( double ) ullMs * dTickRate / 1000.0 );
+}
+
+/* Reads relative deadlines from a task set of the simulator. */
+static int prvLoadTaskSet( const char *pcPath, int xMilliseconds )
+{
+	FILE *pxFile = fopen( pcPath, "r" );
+	char cLine[ 256 ];
+	int iLine = 0;
+
+	if( NULL == pxFile )
+	{
+		perror( pcPath );
+		return 0;
+	}
+
+	while( NULL != fgets( cLine, sizeof( cLine ), pxFile ) )
+	{
+		char cName[ 64 ];
+		unsigned long long ullPhase, ullWCET, ullDeadline, ullPeriod;
+		char *pcComment = strchr( cLine, '#' );
+		int iFields;
+
+		iLine++;
+		if( NULL != pcComment )
+		{
+			*pcComment = '\0';
+		}
+
+		iFields = sscanf( cLine, "%63s %llu %llu %llu %llu", cName, &ullPhase, &ullWCET, &ullDeadline, &ullPeriod );
+		if( iFields <= 0 )
+		{
+			continue;
+		}
+		if( 5 != iFields )
+		{
+			fprintf( stderr, "%s:%d: expected <name> <phase> <WCET> <deadline> <period>\n", pcPath, iLine );
+			fclose( pxFile );
+			return 0;
+		}
+
+		TraceTask_t *pxTask = prvGetTask( cName );
+		if( NULL != pxTask )
+		{
+			pxTask->llRelativeDeadline = ( int64_t ) ( xMilliseconds ? prvMsToTicks( ullDeadline ) : ullDeadline );
+		}
+	}
+
+	fclose( pxFile );
+	return 1;
+}
+
+static void prvPrintStat( const char *pcName, const TraceStat_t *pxStat )
+{
+	if( 0 == pxStat->ullCount )
+	{
+		return;
+	}
+	printf( "  %-14s min %6lld  max %6lld  mean %9.2f  sd %8.2f  jitter %6lld\n", pcName,
+			( long long ) pxStat->llMin, ( long long ) pxStat->llMax, pxStat->dMean,
+			pxStat->ullCount > 1 ? sqrt( pxStat->dM2 / ( double ) ( pxStat->ullCount - 1 ) ) : 0.0,
+			( long long ) ( pxStat->llMax - pxStat->llMin ) );
+}
+
+static void prvPrintSummary( uint64_t ullLines )
+{
+	printf( "%llu lines, ticks %lld at %.3f Hz\n", ( unsigned long long ) ullLines, ( long long ) ( llTickReference < 0 ? 0 : llTickReference ), dTickRate );
+
+	for( int i = 0; i < iTaskCount; i++ )
+	{
+		const TraceTask_t *pxTask = &xTasks[ i ];
+
+		printf( "%s: jobs %llu, misses %llu, late %llu, overruns %llu", pxTask->pcName,
+				( unsigned long long ) pxTask->xSpan.ullCount, ( unsigned long long ) pxTask->ullMisses,
+				( unsigned long long ) pxTask->ullLate, ( unsigned long long ) pxTask->ullOverruns );
+		if( 0 != pxTask->ullBlocked )
+		{
+			printf( ", blocked %llu times for %llu ticks (max %lld)", ( unsigned long long ) pxTask->ullBlocked,
+					( unsigned long long ) pxTask->ullBlockedTicks, ( long long ) pxTask->llMaxBlocked );
+		}
+		putchar( '\n' );
+		prvPrintStat( "response", &pxTask->xResponse );
+		prvPrintStat( "start latency", &pxTask->xStartLatency );
+		prvPrintStat( "span", &pxTask->xSpan );
+		prvPrintStat( "lateness", &pxTask->xLateness );
+	}
+
+	for( int i = 0; i < iResourceCount; i++ )
+	{
+		printf( "%s: locked %llu times\n", xResources[ i ].pcName, ( unsigned long long ) xResources[ i ].ullLocks );
+	}
+}
+
+static void prvUsage( const char *pcProgram )
+{
+	fprintf( stderr,
+			 "usage: %s [-w bits] [-r hz] [-s taskset [-m]] [-o trace.json] [log]\n"
+			 "  -w  bits of the printed ticks, 16 on the ATmega (default), 32 on the host build\n"
+			 "  -r  tick rate (default 62, the 15 ms watchdog tick)\n"
+			 "  -s  task set of the simulator, gives the relative deadlines for response times\n"
+			 "  -m  task set times are in milliseconds\n"
+			 "  -o  write a Chrome trace of the jobs, resource holds, blocking and misses\n"
+			 "  log defaults to stdin\n",
+			 pcProgram );
+}
+
+int main( int argc, char **argv )
+{
+	const char *pcTaskSet = NULL;
+	const char *pcTrace = NULL;
+	int xMilliseconds = 0;
+	FILE *pxIn = stdin;
+	char cLine[ 512 ];
+	uint64_t ullLines = 0;
+	int i;
+
+	for( i = 1; i < argc && '-' == argv[ i ][ 0 ]; i++ )
+	{
+		if( 0 == strcmp( argv[ i ], "-w" ) && i + 1 < argc )
+		{
+			iTickBits = atoi( argv[ ++i ] );
+		}
+		else if( 0 == strcmp( argv[ i ], "-r" ) && i + 1 < argc )
+		{
+			dTickRate = atof( argv[ ++i ] );
+		}
+		else if( 0 == strcmp( argv[ i ], "-s" ) && i + 1 < argc )
+		{
+			pcTaskSet = argv[ ++i ];
+		}
+		else if( 0 == strcmp( argv[ i ], "-m" ) )
+		{
+			xMilliseconds = 1;
+		}
+		else if( 0 == strcmp( argv[ i ], "-o" ) && i + 1 < argc )
+		{
+			pcTrace = argv[ ++i ];
+		}
+		else
+		{
+			prvUsage( argv[ 0 ] );
+			return EXIT_FAILURE;
+		}
+	}
+
+	if( i + 1 < argc || iTickBits < 8 || iTickBits > 64 || dTickRate <= 0.0 )
+	{
+		prvUsage( argv[ 0 ] );
+		return EXIT_FAILURE;
+	}
+	if( NULL != pcTaskSet && !prvLoadTaskSet( pcTaskSet, xMilliseconds ) )
+	{
+		return EXIT_FAILURE;
+	}
+	if( i < argc && NULL == ( pxIn = fopen( argv[ i ], "r" ) ) )
+	{
+		perror( argv[ i ] );
+		return EXIT_FAILURE;
+	}
+	if( NULL != pcTrace && NULL == ( pxTrace = fopen( pcTrace, "w" ) ) )
+	{
+		perror( pcTrace );
+		return EXIT_FAILURE;
+	}
+
+	/* Lanes of the tasks named by -s, in task set order. */
+	for( int iTask = 0; iTask < iTaskCount; iTask++ )
+	{
+		prvTraceLane( prvTaskTid( &xTasks[ iTask ] ), xTasks[ iTask ].pcName );
+	}
+
+	while( NULL != fgets( cLine, sizeof( cLine ), pxIn ) )
+	{
+		ullLines++;
+		prvParseLine( cLine );
+	}
+
+	if( NULL != pxTrace )
+	{
+		if( xFirstEvent )
+		{
+			prvTraceBegin();
+		}
+		fputs( "\n]}\n", pxTrace );
+		fclose( pxTrace );
+	}
+	if( stdin != pxIn )
+	{
+		fclose( pxIn );
+	}
+
+	prvPrintSummary( ullLines );
+
+	return EXIT_SUCCESS;
+}
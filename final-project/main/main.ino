@@ -1,4 +1,4 @@
-#include "project3.h"
+#include "main.h"
 
 #define TASK_SET 	2
 #define NO_OF_TASKS 4
@@ -37,7 +37,12 @@ static void (*Tasks[NO_OF_TASKS])(void *pvParameters) = {Task1, Task2, Task3, Ta
 #endif
 
 void setup() {}
-void loop()  {}
+/* Runs in the idle task, prints what PRINTF stored. */
+void loop()
+{
+	vSchedulerProfileReport();
+	vSchedulerLogDrain();
+}
 
 
 inline void RunCPU(TickType_t uxTicks)
@@ -45,8 +50,8 @@ inline void RunCPU(TickType_t uxTicks)
 	/* Runs the CPU for specified number of ticks*/
 	while(uxTicks--)
 	{
-		// Runs the CPU for 15 ms at FCLK = 16Mhz; 15 ms is WatchDog Timer Interrupt
-		_delay_loop_2(60000);
+		// Runs the CPU for one tick, see schedDELAY_LOOPS_PER_TICK
+		_delay_loop_2(schedDELAY_LOOPS_PER_TICK);
 	}	
 }
 
@@ -1,135 +1,196 @@
-/*
- * FreeRTOS Kernel V10.4.3
- * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
- *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of
- * this software and associated documentation files (the "Software"), to deal in
- * the Software without restriction, including without limitation the rights to
- * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
- * the Software, and to permit persons to whom the Software is furnished to do so,
- * subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all
- * copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
- * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
- * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
- * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
- * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- *
- * https://www.FreeRTOS.org
- * https://github.com/FreeRTOS
- *
- */
-
-#ifndef FREERTOS_CONFIG_H
-#define FREERTOS_CONFIG_H
-
-#include <avr/io.h>
-
-/*-----------------------------------------------------------
- * Application specific definitions.
- *
- * These definitions should be adjusted for your particular hardware and
- * application requirements.
- *
- * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
- * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
- *
- * See https://www.freertos.org/a00110.html.
- *----------------------------------------------------------*/
-
-// And on to the things the same no matter the AVR type...
-#define configUSE_PREEMPTION                1
-
-// Define configUSE_IDLE_HOOK
-#ifndef configUSE_IDLE_HOOK
-    #define configUSE_IDLE_HOOK             1
-#endif
-
-#define configUSE_TICK_HOOK                 1
-#define configCPU_CLOCK_HZ                  ( ( uint32_t ) F_CPU )          // This F_CPU variable set by the environment
-#define configMAX_PRIORITIES                7
-#define configIDLE_SHOULD_YIELD             1
-#define configMINIMAL_STACK_SIZE            ( 192 )
-#define configMAX_TASK_NAME_LEN             ( 8 )
-
-#define configQUEUE_REGISTRY_SIZE           0
-#define configCHECK_FOR_STACK_OVERFLOW      1
-
-#define configUSE_TRACE_FACILITY            0
-#define configUSE_16_BIT_TICKS              1
-
-#define configUSE_MUTEXES                   1
-#define configUSE_RECURSIVE_MUTEXES         1
-#define configUSE_COUNTING_SEMAPHORES       1
-#define configUSE_TIME_SLICING              1
-#define configUSE_QUEUE_SETS                0
-#define configUSE_MALLOC_FAILED_HOOK        1
-
-#define configSUPPORT_DYNAMIC_ALLOCATION    1
-#define configSUPPORT_STATIC_ALLOCATION     0
-
-/* Timer definitions. */
-#define configUSE_TIMERS                    1
-#define configTIMER_TASK_PRIORITY           ( ( UBaseType_t ) 6 )
-#define configTIMER_QUEUE_LENGTH            ( ( UBaseType_t ) 10 )
-#define configTIMER_TASK_STACK_DEPTH        ( 85 )
-
-/* Co-routine definitions. */
-#define configUSE_CO_ROUTINES               0
-#define configMAX_CO_ROUTINE_PRIORITIES     ( (UBaseType_t ) 2 )
-
-#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 2
-
-/* Set the stack depth type to be uint16_t. */
-#define configSTACK_DEPTH_TYPE              uint16_t
-
-/* Set the stack pointer type to be uint16_t, otherwise it defaults to unsigned long */
-#define portPOINTER_SIZE_TYPE               uint16_t
-
-/* Set the following definitions to 1 to include the API function, or zero
-to exclude the API function. */
-
-#define INCLUDE_vTaskPrioritySet                1
-#define INCLUDE_uxTaskPriorityGet               1
-#define INCLUDE_vTaskDelete                     1
-#define INCLUDE_vTaskCleanUpResources           1
-#define INCLUDE_vTaskSuspend                    1
-#define INCLUDE_vResumeFromISR                  1
-#define INCLUDE_xTaskDelayUntil                 1
-#define INCLUDE_vTaskDelay                      1
-#define INCLUDE_xTaskGetSchedulerState          0
-#define INCLUDE_xTaskGetIdleTaskHandle          1 // create an idle task handle.
-#define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     1
-
-#define configMAX(a,b)  ({ __typeof__ (a) _a = (a); __typeof__ (b) _b = (b); _a > _b ? _a : _b; })
-#define configMIN(a,b)  ({ __typeof__ (a) _a = (a); __typeof__ (b) _b = (b); _a < _b ? _a : _b; })
-
-/**
- * configASSERT macro: https://www.freertos.org/a00110.html#configASSERT
- */
-#ifndef configASSERT
-    #define configDEFAULT_ASSERT 0
-#else
-    /**
-     * Enable configASSERT macro if it is defined.
-     */
-    #ifndef configDEFAULT_ASSERT
-        #define configDEFAULT_ASSERT 1
-    #endif
-
-    /**
-     * Define a hook method for configASSERT macro if configASSERT is enabled.
-     */
-    #if configDEFAULT_ASSERT == 1
-        extern void vApplicationAssertHook();
-        #define configASSERT( x ) if (( x ) == 0) { vApplicationAssertHook(); }
-    #endif
-#endif
-
-
-#endif /* FREERTOS_CONFIG_H */
+/*
+ * FreeRTOS Kernel V10.4.3
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <avr/io.h>
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See https://www.freertos.org/a00110.html.
+ *----------------------------------------------------------*/
+
+// And on to the things the same no matter the AVR type...
+#define configUSE_PREEMPTION                1
+
+// Define configUSE_IDLE_HOOK
+#ifndef configUSE_IDLE_HOOK
+    #define configUSE_IDLE_HOOK             1
+#endif
+
+#define configUSE_TICK_HOOK                 1
+#define configCPU_CLOCK_HZ                  ( ( uint32_t ) F_CPU )          // This F_CPU variable set by the environment
+#define configMAX_PRIORITIES                7
+#define configIDLE_SHOULD_YIELD             1
+#define configMINIMAL_STACK_SIZE            ( 192 )
+#define configMAX_TASK_NAME_LEN             ( 8 )
+
+#define configQUEUE_REGISTRY_SIZE           0
+#define configCHECK_FOR_STACK_OVERFLOW      1
+
+#define configUSE_TRACE_FACILITY            0
+#define configUSE_16_BIT_TICKS              1
+
+#define configUSE_MUTEXES                   1
+#define configUSE_RECURSIVE_MUTEXES         1
+#define configUSE_COUNTING_SEMAPHORES       1
+#define configUSE_TIME_SLICING              1
+#define configUSE_QUEUE_SETS                0
+#define configUSE_MALLOC_FAILED_HOOK        1
+
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configSUPPORT_STATIC_ALLOCATION     0
+
+/* Timer definitions. */
+#define configUSE_TIMERS                    1
+#define configTIMER_TASK_PRIORITY           ( ( UBaseType_t ) 6 )
+#define configTIMER_QUEUE_LENGTH            ( ( UBaseType_t ) 10 )
+#define configTIMER_TASK_STACK_DEPTH        ( 85 )
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES               0
+#define configMAX_CO_ROUTINE_PRIORITIES     ( (UBaseType_t ) 2 )
+
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 2
+
+/* Set the stack depth type to be uint16_t. */
+#define configSTACK_DEPTH_TYPE              uint16_t
+
+/* Set the stack pointer type to be uint16_t, otherwise it defaults to unsigned long */
+#define portPOINTER_SIZE_TYPE               uint16_t
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskCleanUpResources           1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vResumeFromISR                  1
+#define INCLUDE_xTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          0
+#define INCLUDE_xTaskGetIdleTaskHandle          1 // create an idle task handle.
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+
+#define configMAX(a,b)  ({ __typeof__ (a) _a = (a); __typeof__ (b) _b = (b); _a > _b ? _a : _b; })
+#define configMIN(a,b)  ({ __typeof__ (a) _a = (a); __typeof__ (b) _b = (b); _a < _b ? _a : _b; })
+
+/**
+ * configASSERT macro: https://www.freertos.org/a00110.html#configASSERT
+ */
+#ifndef configASSERT
+    #define configDEFAULT_ASSERT 0
+#else
+    /**
+     * Enable configASSERT macro if it is defined.
+     */
+    #ifndef configDEFAULT_ASSERT
+        #define configDEFAULT_ASSERT 1
+    #endif
+
+    /**
+     * Define a hook method for configASSERT macro if configASSERT is enabled.
+     */
+    #if configDEFAULT_ASSERT == 1
+        extern void vApplicationAssertHook();
+        #define configASSERT( x ) if (( x ) == 0) { vApplicationAssertHook(); }
+    #endif
+#endif
+
+
+/**
+ * Set schedUSE_TIMER1_TICK to 1 to drive the tick from the Timer1 compare A
+ * interrupt every schedTICK_PERIOD_US microseconds instead of from the 15 ms
+ * watchdog, see scheduler.h. Timer1 runs free at clk/1, so the period is at
+ * most 65535 cycles (4095 us at 16 MHz).
+ */
+#ifndef schedUSE_TIMER1_TICK
+    #define schedUSE_TIMER1_TICK 0
+#endif
+
+#if( schedUSE_TIMER1_TICK == 1 )
+    #ifndef schedTICK_PERIOD_US
+        #define schedTICK_PERIOD_US 1000
+    #endif
+    #if( ( F_CPU / 1000000UL ) * schedTICK_PERIOD_US > 65535UL )
+        #error "schedTICK_PERIOD_US is longer than one Timer1 period"
+    #endif
+    /* The 16 bit product of the kernel's pdMS_TO_TICKS overflows at these rates. */
+    #define pdMS_TO_TICKS( xTimeInMs )    ( ( TickType_t ) ( ( ( uint32_t ) ( xTimeInMs ) * 1000UL ) / schedTICK_PERIOD_US ) )
+#endif /* schedUSE_TIMER1_TICK */
+
+/**
+ * Set schedUSE_TICKLESS_IDLE to 1 to stop the watchdog tick and power down while
+ * every task is blocked, up to the next release or scheduler timeout. See
+ * vSchedulerSuppressTicksAndSleep() in scheduler.cpp.
+ */
+#ifndef schedUSE_TICKLESS_IDLE
+    #define schedUSE_TICKLESS_IDLE 0
+#endif
+
+#if( schedUSE_TICKLESS_IDLE == 1 )
+    #if( schedUSE_TIMER1_TICK == 1 )
+        #error "schedUSE_TICKLESS_IDLE needs the watchdog tick, Timer1 stops in power-down"
+    #endif
+    #define configUSE_TICKLESS_IDLE                 2
+    #define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    vSchedulerSuppressTicksAndSleep( xExpectedIdleTime )
+#endif /* schedUSE_TICKLESS_IDLE */
+
+/**
+ * Set schedUSE_EXACT_EXEC_TIME to 1 to charge jobs their execution time in CPU
+ * cycles from switch in to switch out instead of in whole ticks, see scheduler.h.
+ */
+#ifndef schedUSE_EXACT_EXEC_TIME
+    #define schedUSE_EXACT_EXEC_TIME 0
+#endif
+
+#if( schedUSE_EXACT_EXEC_TIME == 1 )
+#ifdef __cplusplus
+extern "C" {
+#endif
+    void vSchedulerTaskSwitchedIn( void );
+    void vSchedulerTaskSwitchedOut( void );
+#ifdef __cplusplus
+}
+#endif
+#define traceTASK_SWITCHED_IN()     vSchedulerTaskSwitchedIn()
+#define traceTASK_SWITCHED_OUT()    vSchedulerTaskSwitchedOut()
+#endif /* schedUSE_EXACT_EXEC_TIME */
+
+
+#endif /* FREERTOS_CONFIG_H */
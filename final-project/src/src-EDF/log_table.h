@@ -0,0 +1,41 @@
+/* PRINTF formats for schedLOG_TOKENIZED, the index of a format is the ID
+ * sent in its frames. Generated by final-project/host/logtoken -g from
+ *   scheduler.cpp main.ino
+ * Regenerate it after changing a PRINTF format. */
+
+#ifndef LOG_TABLE_H_
+#define LOG_TABLE_H_
+
+static constexpr const char *pcSchedulerLogTable[] =
+{
+	"PROF unit: %s\n",
+	"PROF %s n=%lu min=%lu avg=%lu max=%lu\n",
+	"PROF %s <%lu: %u\n",
+	"PROF %s >=%lu: %u\n",
+	"FUNC: %s",
+	" -> TASK: %s, INIT RUN\n",
+	"TASK: %-2s\n",
+	"STAT: %-2s, ST:%04u, ET:%04u, RT:%02u, DT: %04u\n",
+	"FUNC: %s\n",
+	"---- Task Details ----\n",
+	"Name                : %s\n",
+	"Phase Tick          : %u\n",
+	"Max. Execution Tick : %u\n",
+	"Rel. Deadline Tick  : %u\n",
+	"Period Tick         : %u\n",
+	"Priority            : %d\n",
+	"----------------------\n\n",
+	" -> TASK: %s, T : %d\n",
+	"---- Scheduler Details ----\n",
+	"Priority     : %d\n",
+	"---------------------------\n\n",
+	"U : %lu/1000\n",
+	"----Task set is not feasible, U > 1----\n\n",
+	"----Task set is not feasible, no bound below %lu----\n\n",
+	"L : %lu\n",
+	"----Task set is not feasible, h(%lu) = %lu----\n\n",
+	"----Task set is feasible----\n\n",
+	"Not started\n"
+};
+
+#endif /* LOG_TABLE_H_ */
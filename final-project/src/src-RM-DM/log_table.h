@@ -0,0 +1,44 @@
+/* PRINTF formats for schedLOG_TOKENIZED, the index of a format is the ID
+ * sent in its frames. Generated by final-project/host/logtoken -g from
+ *   scheduler.cpp main.ino
+ * Regenerate it after changing a PRINTF format. */
+
+#ifndef LOG_TABLE_H_
+#define LOG_TABLE_H_
+
+static constexpr const char *pcSchedulerLogTable[] =
+{
+	"PROF unit: %s\n",
+	"PROF %s n=%lu min=%lu avg=%lu max=%lu\n",
+	"PROF %s <%lu: %u\n",
+	"PROF %s >=%lu: %u\n",
+	"FUNC: %s",
+	" -> TASK: %s, INIT RUN\n",
+	"TASK: %-2s\n",
+	"STAT: %-2s, ST:%04u, ET:%04u, RT:%02u, DT: %04u\n",
+	"FUNC: %s\n",
+	"---- Task Details ----\n",
+	"Name                : %s\n",
+	"Phase Tick          : %u\n",
+	"Max. Execution Tick : %u\n",
+	"Rel. Deadline Tick  : %u\n",
+	"Period Tick         : %u\n",
+	"Priority            : %d\n",
+	"----------------------\n\n",
+	"----Using RM Scheduling Algorithm----\n",
+	"----Using DM Scheduling Algorithm----\n",
+	" Task : %s, Priority : %d, Tick : %d\n",
+	"-------------------------------------\n\n",
+	"Scheduler cost per job : %d\n",
+	" Task : %s, R : %lu, D : %lu\n",
+	" Task : %s, R > %lu, can miss its deadline\n",
+	"----Task set is not feasible----\n",
+	" -> TASK: %s, T : %d\n",
+	"---- Scheduler Details ----\n",
+	"Priority     : %d\n",
+	"Overhead     : %d\n",
+	"---------------------------\n\n",
+	"Not started\n"
+};
+
+#endif /* LOG_TABLE_H_ */
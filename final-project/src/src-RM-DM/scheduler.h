@@ -1,102 +1,322 @@
-#ifndef SCHEDULER_H_
-#define SCHEDULER_H_
-
-#include <Arduino_FreeRTOS.h>
-#include <task.h>
-#include <projdefs.h>
-#include <timers.h>
-#include <list.h>
-#include <croutine.h>
-#include <portable.h>
-#include <stack_macros.h>
-#include <mpu_wrappers.h>
-#include <FreeRTOSVariant.h>
-#include <message_buffer.h>
-#include <semphr.h>
-#include <FreeRTOSConfig.h>
-#include <stream_buffer.h>
-#include <portmacro.h>
-#include <event_groups.h>
-#include <queue.h>
-#include <Arduino.h>
-#include <util/delay_basic.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* The scheduling policy can be chosen from one of these. */
-#define schedSCHEDULING_POLICY_RMS 1 		/* Rate-monotonic scheduling */
-#define schedSCHEDULING_POLICY_DMS 2 		/* Deadline-monotonic scheduling */
-
-/* Configure scheduling policy by setting this define to the appropriate one. */
-#define schedSCHEDULING_POLICY schedSCHEDULING_POLICY_RMS
-// #define schedSCHEDULING_POLICY schedSCHEDULING_POLICY_RMS
-
-/* Maximum number of periodic tasks that can be created. (Scheduler task is
- * not included) */
-#define schedMAX_NUMBER_OF_PERIODIC_TASKS 6
-
-/* Set this define to 1 to enable Timing-Error-Detection for detecting tasks
- * that have missed their deadlines. Tasks that have missed their deadlines
- * will be deleted, recreated and restarted during next period. */
-#define schedUSE_TIMING_ERROR_DETECTION_DEADLINE 1
-
-/* Set this define to 1 to enable Timing-Error-Detection for detecting tasks
- * that have exceeded their worst-case execution time. Tasks that have exceeded
- * their worst-case execution time will be preempted until next period. */
-#define schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME 1
-
-
-/* Set this define to 1 to enable the scheduler task. This define must be set to 1
-* when using following features:
-* EDF scheduling policy, Timing-Error-Detection of execution time,
-* Timing-Error-Detection of deadline, Polling Server. */
-#define schedUSE_SCHEDULER_TASK 1
-
-#if( schedUSE_SCHEDULER_TASK == 1 )
-	/* Priority of the scheduler task. */
-	#define schedSCHEDULER_PRIORITY ( configMAX_PRIORITIES - 1 )
-	/* Stack size of the scheduler task. */
-	#define schedSCHEDULER_TASK_STACK_SIZE 200 
-	/* The period of the scheduler task in software ticks. */
-	#define schedSCHEDULER_TASK_PERIOD pdMS_TO_TICKS(50)
-	
-	/* Set the schedOVERHEAD to enable scheduler overhead */
-	#define schedOVERHEAD 0
-	/* No. of Ticks for scheduler overhead */
-	#define schedOVERHEAD_TICKS 2
-
-#endif /* schedUSE_SCHEDULER_TASK */
-
-/* This function must be called before any other function call from scheduler.h. */
-void vSchedulerInit( void );
-
-/* Creates a periodic task.
- *
- * pvTaskCode: The task function.
- * pcName: Name of the task.
- * usStackDepth: Stack size of the task in words, not bytes.
- * pvParameters: Parameters to the task function.
- * uxPriority: Priority of the task. (Only used when scheduling policy is set to manual)
- * pxCreatedTask: Pointer to the task handle.
- * xPhaseTick: Phase given in software ticks. Counted from when vSchedulerStart is called.
- * xPeriodTick: Period given in software ticks.
- * xMaxExecTimeTick: Worst-case execution time given in software ticks.
- * xDeadlineTick: Relative deadline given in software ticks.
- * */
-void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, UBaseType_t uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
-		TaskHandle_t *pxCreatedTask, TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick );
-
-/* Deletes a periodic task associated with the given task handle. */
-void vSchedulerPeriodicTaskDelete( TaskHandle_t xTaskHandle );
-
-/* Starts scheduling tasks. */
-void vSchedulerStart( void );
-
-#ifdef __cplusplus
-}
-#endif
-
-
-#endif /* SCHEDULER_H_ */
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <Arduino_FreeRTOS.h>
+#include <task.h>
+#include <projdefs.h>
+#include <timers.h>
+#include <list.h>
+#include <croutine.h>
+#include <portable.h>
+#include <stack_macros.h>
+#include <mpu_wrappers.h>
+#include <FreeRTOSVariant.h>
+#include <message_buffer.h>
+#include <semphr.h>
+#include <FreeRTOSConfig.h>
+#include <stream_buffer.h>
+#include <portmacro.h>
+#include <event_groups.h>
+#include <queue.h>
+#include <Arduino.h>
+#include <util/delay_basic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The scheduling policy can be chosen from one of these. */
+#define schedSCHEDULING_POLICY_RMS 1 		/* Rate-monotonic scheduling */
+#define schedSCHEDULING_POLICY_DMS 2 		/* Deadline-monotonic scheduling */
+
+/* Configure scheduling policy by setting this define to the appropriate one. */
+#ifndef schedSCHEDULING_POLICY
+	#define schedSCHEDULING_POLICY schedSCHEDULING_POLICY_RMS
+	// #define schedSCHEDULING_POLICY schedSCHEDULING_POLICY_RMS
+#endif
+
+/* Set this define to 1 to create the periodic tasks and the scheduler task
+ * with xTaskCreateStatic() from pools sized by schedMAX_NUMBER_OF_PERIODIC_TASKS,
+ * so that their RAM is known at link time and the heap is not used. Needs
+ * configSUPPORT_STATIC_ALLOCATION 1, and with it vApplicationGetIdleTaskMemory(). */
+#ifndef schedUSE_STATIC_ALLOCATION
+	#define schedUSE_STATIC_ALLOCATION 0
+#endif
+
+#if( schedUSE_STATIC_ALLOCATION == 1 )
+	/* Stack size of every periodic task in the pool. The uxStackDepth given to
+	 * vSchedulerPeriodicTaskCreate must not be larger. */
+	#ifndef schedSTATIC_TASK_STACK_SIZE
+		#define schedSTATIC_TASK_STACK_SIZE configMINIMAL_STACK_SIZE
+	#endif
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 0 )
+		#error "schedUSE_STATIC_ALLOCATION needs configSUPPORT_STATIC_ALLOCATION 1"
+	#endif
+#endif /* schedUSE_STATIC_ALLOCATION */
+
+#if( DEBUG && schedLOG_DEFERRED == 1 )
+	/* Number of PRINTF records the log ring holds, a power of 2 up to 128. A
+	 * record takes 24 bytes of RAM on the ATmega. When the ring is full new
+	 * records are dropped and counted. */
+	#ifndef schedLOG_RING_LENGTH
+		#define schedLOG_RING_LENGTH 16
+	#endif
+
+	#if( ( schedLOG_RING_LENGTH & ( schedLOG_RING_LENGTH - 1 ) ) != 0 || schedLOG_RING_LENGTH > 128 )
+		#error "schedLOG_RING_LENGTH must be a power of 2 up to 128"
+	#endif
+
+	#if( schedLOG_TOKENIZED == 1 )
+		/* Longest string argument sent in a frame, longer ones are cut. */
+		#ifndef schedLOG_MAX_STRING
+			#define schedLOG_MAX_STRING 32
+		#endif
+
+		/* Frame ID that reports the number of dropped records. */
+		#define schedLOG_DROPPED_ID 0xFF
+	#endif /* schedLOG_TOKENIZED */
+#endif /* schedLOG_DEFERRED */
+
+/* Set this define to 1 to enable Timing-Error-Detection for detecting tasks
+ * that have missed their deadlines. Tasks that have missed their deadlines
+ * will be deleted, recreated and restarted during next period. */
+#define schedUSE_TIMING_ERROR_DETECTION_DEADLINE 1
+
+/* Set this define to 1 to restart a task that has missed its deadline with
+ * vTaskRestart() instead of deleting and recreating it, so that no memory is
+ * freed or allocated. Needs project-1's tasks.cpp built with P_RESTART 1 and
+ * P_TEST 0, P_TEST 1 inverts the priorities the scheduler assigns. */
+#ifndef schedUSE_TASK_RESTART
+	#define schedUSE_TASK_RESTART 0
+#endif
+
+#if( schedUSE_TASK_RESTART == 1 && !P_RESTART )
+	#error "schedUSE_TASK_RESTART needs the project-1 kernel built with P_RESTART 1"
+#endif
+
+#if( schedUSE_TASK_RESTART == 1 && P_TEST )
+	#error "schedUSE_TASK_RESTART needs the project-1 kernel built with P_TEST 0"
+#endif
+
+/* Set this define to 1 to enable Timing-Error-Detection for detecting tasks
+ * that have exceeded their worst-case execution time. Tasks that have exceeded
+ * their worst-case execution time will be preempted until next period. */
+#define schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME 1
+
+
+/* Set this define to 1 to enable the scheduler task. This define must be set to 1
+* when using following features:
+* EDF scheduling policy, Timing-Error-Detection of execution time,
+* Timing-Error-Detection of deadline, Polling Server. */
+#define schedUSE_SCHEDULER_TASK 1
+
+#if( schedUSE_SCHEDULER_TASK == 1 )
+	/* Priority of the scheduler task. */
+	#define schedSCHEDULER_PRIORITY ( configMAX_PRIORITIES - 1 )
+	/* Stack size of the scheduler task. */
+	#ifndef schedSCHEDULER_TASK_STACK_SIZE
+		#define schedSCHEDULER_TASK_STACK_SIZE 200
+	#endif
+	
+	/* Set the schedOVERHEAD to enable scheduler overhead */
+	#define schedOVERHEAD 0
+	/* No. of Ticks for scheduler overhead */
+	#define schedOVERHEAD_TICKS 2
+
+#endif /* schedUSE_SCHEDULER_TASK */
+
+/* Set this define to 1 to run the periodic tasks on three kernel priorities,
+ * so their number is not limited by configMAX_PRIORITIES. The RM/DM priorities
+ * then only order the jobs: the first ready job runs at schedBAND_RUN_PRIORITY,
+ * the other ready jobs wait at schedBAND_READY_PRIORITY, and a job is released
+ * at schedBAND_RELEASE_PRIORITY to compare itself with the running one.
+ * The order is exact only while jobs do not block: a running job that waits in
+ * vTaskDelay() or on a semaphore keeps schedBAND_RUN_PRIORITY, and the ready
+ * jobs time slice at schedBAND_READY_PRIORITY until it runs again. */
+#ifndef schedUSE_PRIORITY_BANDING
+	#define schedUSE_PRIORITY_BANDING 0
+#endif
+
+#if( schedUSE_PRIORITY_BANDING == 1 )
+	#define schedBAND_READY_PRIORITY	( tskIDLE_PRIORITY + 1 )
+	#define schedBAND_RUN_PRIORITY		( tskIDLE_PRIORITY + 2 )
+	#define schedBAND_RELEASE_PRIORITY	( tskIDLE_PRIORITY + 3 )
+
+	#if( ( schedUSE_SCHEDULER_TASK == 1 && configMAX_PRIORITIES < 5 ) || configMAX_PRIORITIES < 4 )
+		#error "schedUSE_PRIORITY_BANDING needs 3 priorities between the idle task and the scheduler task"
+	#endif
+#endif /* schedUSE_PRIORITY_BANDING */
+
+/* Maximum number of periodic tasks that can be created. (Scheduler task is
+ * not included) Without banding each task also needs a kernel priority. */
+#ifndef schedMAX_NUMBER_OF_PERIODIC_TASKS
+	#if( schedUSE_PRIORITY_BANDING == 1 )
+		#define schedMAX_NUMBER_OF_PERIODIC_TASKS 32
+	#else
+		#define schedMAX_NUMBER_OF_PERIODIC_TASKS 6
+	#endif
+#endif
+
+/* Set this define to 1 to run a response-time analysis of the fixed priorities
+ * in vSchedulerStart() and print each task's worst-case response time in
+ * ticks. Integer only, one recurrence per task. */
+#ifndef schedUSE_RESPONSE_TIME_ANALYSIS
+	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
+		#define schedUSE_RESPONSE_TIME_ANALYSIS 1
+	#else
+		#define schedUSE_RESPONSE_TIME_ANALYSIS 0
+	#endif
+#endif
+
+#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+	/* Set this define to 1 to not start a task set that can miss a deadline,
+	 * otherwise it is only reported. */
+	#ifndef schedRTA_REFUSE_INFEASIBLE
+		#define schedRTA_REFUSE_INFEASIBLE 0
+	#endif
+
+	/* Ticks the scheduler task takes each time it runs, rounded up. It runs
+	 * once per job of every task. The Scheduler site of
+	 * schedUSE_OVERHEAD_PROFILING gives its max in cycles, well below the
+	 * 15 ms tick, so one tick bounds it; raise it for a short
+	 * schedTICK_PERIOD_US. schedOVERHEAD adds its busy wait. */
+	#ifndef schedRTA_SCHEDULER_COST
+		#if( schedUSE_SCHEDULER_TASK == 1 && schedOVERHEAD == 1 )
+			#define schedRTA_SCHEDULER_COST ( schedOVERHEAD_TICKS + 1 )
+		#elif( schedUSE_SCHEDULER_TASK == 1 )
+			#define schedRTA_SCHEDULER_COST 1
+		#else
+			#define schedRTA_SCHEDULER_COST 0
+		#endif
+	#endif
+
+	#if( schedUSE_SCHEDULER_TASK == 1 && schedRTA_SCHEDULER_COST == 0 )
+		#error "schedRTA_SCHEDULER_COST must be at least one tick with schedUSE_SCHEDULER_TASK"
+	#endif
+
+	#if( schedSCHEDULING_POLICY != schedSCHEDULING_POLICY_RMS && schedSCHEDULING_POLICY != schedSCHEDULING_POLICY_DMS )
+		#error "schedUSE_RESPONSE_TIME_ANALYSIS needs fixed RM or DM priorities"
+	#endif
+#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+/* Set this define to 1 to time the tick hook and the scheduler task with a free-running counter: Timer1 at clk/1
+ * on the ATmega, counting cycles, and CLOCK_MONOTONIC on the host, counting
+ * ns. Keeps min/avg/max and a log2 histogram per site. Timer1 is then taken. */
+#ifndef schedUSE_OVERHEAD_PROFILING
+	#define schedUSE_OVERHEAD_PROFILING 0
+#endif
+
+#if( schedUSE_OVERHEAD_PROFILING == 1 )
+	/* vSchedulerProfileReport() prints at most once per this many ticks. */
+	#ifndef schedPROFILE_REPORT_TICKS
+		#define schedPROFILE_REPORT_TICKS pdMS_TO_TICKS( 10000 )
+	#endif
+	/* Histogram bin n counts samples below 2^( schedPROFILE_BIN_SHIFT + n ),
+	 * the last bin all longer ones. */
+	#ifndef schedPROFILE_BINS
+		#define schedPROFILE_BINS 12
+	#endif
+	#ifndef schedPROFILE_BIN_SHIFT
+		#define schedPROFILE_BIN_SHIFT 6
+	#endif
+#endif /* schedUSE_OVERHEAD_PROFILING */
+
+/* schedUSE_EXACT_EXEC_TIME is set in FreeRTOSConfig.h, where it installs the
+ * task switch hooks. Jobs are then charged the Timer1 cycles between their
+ * switch in and switch out instead of whole ticks, and a job that uses up its
+ * worst-case execution time is stopped by the Timer1 compare B interrupt
+ * instead of at the next tick. Timer1 is shared with the overhead profiling. */
+#if( schedUSE_EXACT_EXEC_TIME == 1 )
+	/* CPU cycles per tick, turns worst-case execution times into budgets. */
+	#ifndef schedCYCLES_PER_TICK
+		#if( schedUSE_TIMER1_TICK == 1 )
+			#define schedCYCLES_PER_TICK ( ( uint32_t ) ( configCPU_CLOCK_HZ / 1000000UL ) * schedTICK_PERIOD_US )
+		#else
+			#define schedCYCLES_PER_TICK ( ( uint32_t ) ( configCPU_CLOCK_HZ / 1000UL ) * portTICK_PERIOD_MS )
+		#endif
+	#endif
+
+	#if( schedUSE_SCHEDULER_TASK == 0 )
+		#error "schedUSE_EXACT_EXEC_TIME needs schedUSE_SCHEDULER_TASK 1"
+	#endif
+#endif /* schedUSE_EXACT_EXEC_TIME */
+
+/* schedUSE_TIMER1_TICK is set in FreeRTOSConfig.h, where it sets the tick rate.
+ * The port still starts the watchdog tick; the scheduler task stops it when it
+ * first runs and ticks from Timer1 compare A instead. */
+#if( schedUSE_TIMER1_TICK == 1 && schedUSE_SCHEDULER_TASK == 0 )
+	#error "schedUSE_TIMER1_TICK needs schedUSE_SCHEDULER_TASK 1"
+#endif
+
+/* _delay_loop_2() iterations (4 cycles each) that take one tick, for RunCPU(). */
+#ifndef schedDELAY_LOOPS_PER_TICK
+	#if( schedUSE_TIMER1_TICK == 1 )
+		#define schedDELAY_LOOPS_PER_TICK ( ( uint16_t ) ( ( F_CPU / 4000000UL ) * schedTICK_PERIOD_US ) )
+	#else
+		/* 15 ms watchdog tick at 16 MHz. */
+		#define schedDELAY_LOOPS_PER_TICK ( ( uint16_t ) 60000 )
+	#endif
+#endif
+
+/* schedUSE_TICKLESS_IDLE is set in FreeRTOSConfig.h, where it installs
+ * vSchedulerSuppressTicksAndSleep() as portSUPPRESS_TICKS_AND_SLEEP. */
+#if( schedUSE_TICKLESS_IDLE == 1 )
+	/* Longest single sleep, as a watchdog timeout of 2^n ticks. 4 takes the
+	 * WDTO_15MS tick to WDTO_250MS, up to 9 for WDTO_8S. Longer idle times are
+	 * slept in several of these, and an interrupt that readies a task loses
+	 * at most the ticks of the one it ends. */
+	#ifndef schedTICKLESS_MAX_WDTO
+		#define schedTICKLESS_MAX_WDTO 4
+	#endif
+
+	#if( schedUSE_SCHEDULER_TASK == 0 )
+		#error "schedUSE_TICKLESS_IDLE needs schedUSE_SCHEDULER_TASK 1"
+	#endif
+#endif /* schedUSE_TICKLESS_IDLE */
+
+/* This function must be called before any other function call from scheduler.h. */
+void vSchedulerInit( void );
+
+/* Creates a periodic task.
+ *
+ * pvTaskCode: The task function.
+ * pcName: Name of the task.
+ * usStackDepth: Stack size of the task in words, not bytes.
+ * pvParameters: Parameters to the task function.
+ * uxPriority: Priority of the task. (Only used when scheduling policy is set to manual)
+ * pxCreatedTask: Pointer to the task handle.
+ * xPhaseTick: Phase given in software ticks. Counted from when vSchedulerStart is called.
+ * xPeriodTick: Period given in software ticks.
+ * xMaxExecTimeTick: Worst-case execution time given in software ticks.
+ * xDeadlineTick: Relative deadline given in software ticks.
+ * */
+void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, UBaseType_t uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
+		TaskHandle_t *pxCreatedTask, TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick );
+
+/* Deletes a periodic task associated with the given task handle. */
+void vSchedulerPeriodicTaskDelete( TaskHandle_t xTaskHandle );
+
+/* Starts scheduling tasks. */
+void vSchedulerStart( void );
+
+#if( schedUSE_OVERHEAD_PROFILING == 1 )
+	/* Prints the overhead statistics of every site. Call it from loop(). */
+	void vSchedulerProfileReport( void );
+#else
+	#define vSchedulerProfileReport()
+#endif /* schedUSE_OVERHEAD_PROFILING */
+
+#if( schedUSE_EXACT_EXEC_TIME == 1 )
+	/* Called from traceTASK_SWITCHED_IN and traceTASK_SWITCHED_OUT in
+	 * FreeRTOSConfig.h. Must not be called by the application. */
+	void vSchedulerTaskSwitchedIn( void );
+	void vSchedulerTaskSwitchedOut( void );
+#endif /* schedUSE_EXACT_EXEC_TIME */
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* SCHEDULER_H_ */
@@ -32,7 +32,19 @@
     #error "include Arduino_FreeRTOS.h must appear in source files before include task.h"
 #endif
 
-#define P_TEST      1
+/* P_TEST 1 inverts the priority order, 0 is then the highest priority. */
+#ifndef P_TEST
+    #define P_TEST      1
+#endif
+/* P_EDF 1 orders the tasks of a ready list by the deadlines given with
+ * vTaskDeadlineSet(), see below. */
+#ifndef P_EDF
+    #define P_EDF       0
+#endif
+/* P_RESTART 1 adds vTaskRestart(), see below. */
+#ifndef P_RESTART
+    #define P_RESTART   0
+#endif
 #define P_DEBUG     0
 
 #include "list.h"
@@ -1071,6 +1083,64 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+#if P_EDF
+
+/**
+ * task. h
+ * <pre>
+ * void vTaskDeadlineSet( TaskHandle_t xTask, TickType_t xNewDeadline );
+ * </pre>
+ *
+ * P_EDF must be defined as 1 for this function to be available.
+ *
+ * Set the absolute deadline of a task.  From then on the task is kept ahead of
+ * the tasks of the same priority that have a later deadline or no deadline,
+ * so earliest deadline first scheduling needs no priority changes.  All tasks
+ * scheduled by deadline should be given the same priority.
+ *
+ * A context switch will occur before the function returns if the task with
+ * the earliest deadline has changed.
+ *
+ * @param xTask Handle to the task for which the deadline is being set.
+ * Passing a NULL handle results in the deadline of the calling task being set.
+ *
+ * @param xNewDeadline The absolute deadline in ticks.
+ *
+ * \defgroup vTaskDeadlineSet vTaskDeadlineSet
+ * \ingroup TaskCtrl
+ */
+void vTaskDeadlineSet( TaskHandle_t xTask,
+                       TickType_t xNewDeadline ) PRIVILEGED_FUNCTION;
+
+#endif /* P_EDF */
+
+#if P_RESTART
+
+/**
+ * task. h
+ * <pre>
+ * void vTaskRestart( TaskHandle_t xTaskToRestart );
+ * </pre>
+ *
+ * P_RESTART must be defined as 1 for this function to be available.
+ *
+ * Make a task start over from the top of its task function, as if it had just
+ * been created.  The task keeps its TCB, stack, handle, priority and thread
+ * local storage pointers, so no memory is freed or allocated.  Its pending
+ * notifications are cleared and it is placed in the ready state, whatever
+ * state it was in before.
+ *
+ * A task cannot restart itself, and the task must not hold a mutex.
+ *
+ * @param xTaskToRestart Handle to the task to restart.
+ *
+ * \defgroup vTaskRestart vTaskRestart
+ * \ingroup TaskCtrl
+ */
+void vTaskRestart( TaskHandle_t xTaskToRestart ) PRIVILEGED_FUNCTION;
+
+#endif /* P_RESTART */
+
 /**
  * task. h
  * <pre>
@@ -138,6 +138,38 @@ f * FreeRTOS Kernel V10.4.3
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
+#if P_EDF
+
+/* Tasks that have a deadline are kept at the front of their ready list, sorted
+ * by absolute deadline, and the head of the list is always selected.  Tasks
+ * without a deadline share the rest of the list round robin as usual. */
+    #define taskSELECT_FROM_READY_LIST( pxList )                                              \
+    {                                                                                       \
+        TCB_t * pxHeadTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList );              \
+                                                                                            \
+        if( pxHeadTCB->xHasDeadline != pdFALSE )                                            \
+        {                                                                                   \
+            pxCurrentTCB = pxHeadTCB;                                                       \
+        }                                                                                   \
+        else                                                                                \
+        {                                                                                   \
+            listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, ( pxList ) );                        \
+        }                                                                                   \
+    }
+
+/* pdTRUE if deadline xA is earlier than deadline xB.  Uses the ICTOH method
+ * proposed by Carlini and Buttazzo, so tick count overflows do not matter as
+ * long as all deadlines are within half the tick range of each other. */
+    #define taskDEADLINE_IS_BEFORE( xA, xB )    ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+
+#else /* P_EDF */
+
+    #define taskSELECT_FROM_READY_LIST( pxList )    listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, ( pxList ) )
+
+#endif /* P_EDF */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -189,7 +221,7 @@ f * FreeRTOS Kernel V10.4.3
                                                                               \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskSELECT_FROM_READY_LIST( &( pxReadyTasksLists[ uxTopPriority ] ) );                \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -209,7 +241,7 @@ f * FreeRTOS Kernel V10.4.3
                                                                               \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskSELECT_FROM_READY_LIST( &( pxReadyTasksLists[ uxTopPriority ] ) );                \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -241,7 +273,7 @@ f * FreeRTOS Kernel V10.4.3
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskSELECT_FROM_READY_LIST( &( pxReadyTasksLists[ uxTopPriority ] ) );                  \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 /*-----------------------------------------------------------*/
@@ -283,12 +315,33 @@ f * FreeRTOS Kernel V10.4.3
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
+#if P_EDF
+
+/* A task with a deadline is inserted in deadline order instead. */
+#define prvAddTaskToReadyList( pxTCB )                                                                 \
+    PRINTLN("  -> ADD TASK TO READY LIST");                                                            \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
+    if( ( pxTCB )->xHasDeadline != pdFALSE )                                                           \
+    {                                                                                                  \
+        prvInsertTaskByDeadline( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), ( pxTCB ) );         \
+    }                                                                                                  \
+    else                                                                                               \
+    {                                                                                                  \
+        listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+    }                                                                                                  \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#else
+
 #define prvAddTaskToReadyList( pxTCB )                                                                 \
     PRINTLN("  -> ADD TASK TO READY LIST");                                                            \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
+#endif /* P_EDF */
 /*-----------------------------------------------------------*/
 
 /*
@@ -395,6 +448,17 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if P_EDF
+        TickType_t xDeadline;    /*< Absolute deadline, orders the task within its ready list. */
+        BaseType_t xHasDeadline; /*< pdFALSE until vTaskDeadlineSet() is called for the task. */
+    #endif
+
+    #if P_RESTART
+        TaskFunction_t pxTaskCode;    /*< Entry point and parameters, used by vTaskRestart() to build the initial context again. */
+        void * pvParameters;
+        StackType_t * pxStartOfStack; /*< Top of stack before the initial context was built. */
+    #endif
 } TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
@@ -600,6 +664,17 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if P_EDF
+
+/*
+ * Insert pxTCB into the ready list pxList behind all tasks with an earlier or
+ * equal deadline, and in front of the tasks without a deadline.
+ */
+    static void prvInsertTaskByDeadline( List_t * const pxList,
+                                         TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* P_EDF */
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 /*
@@ -1047,6 +1122,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         }
     #endif /* configGENERATE_RUN_TIME_STATS */
 
+    #if P_EDF
+        {
+            pxNewTCB->xDeadline = ( TickType_t ) 0U;
+            pxNewTCB->xHasDeadline = pdFALSE;
+        }
+    #endif /* P_EDF */
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
         {
             vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1086,6 +1168,14 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         }
     #endif
 
+    #if P_RESTART
+        {
+            pxNewTCB->pxTaskCode = pxTaskCode;
+            pxNewTCB->pvParameters = pvParameters;
+            pxNewTCB->pxStartOfStack = pxTopOfStack;
+        }
+    #endif /* P_RESTART */
+
     /* Initialize the TCB stack to look as if the task was already running,
      * but had been interrupted by the scheduler.  The return address is set
      * to the start of the task function. Once the stack has been initialised
@@ -1343,6 +1433,106 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if P_RESTART
+
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+        #error vTaskRestart() does not support MPU ports
+    #endif
+
+    void vTaskRestart( TaskHandle_t xTaskToRestart )
+    {
+        PRINT_FUNC_NAME;
+
+        TCB_t * const pxTCB = ( TCB_t * ) xTaskToRestart;
+
+        configASSERT( xTaskToRestart );
+
+        /* The context of the running task would be saved over the new one
+         * when it is switched out. */
+        configASSERT( pxTCB != pxCurrentTCB );
+
+        taskENTER_CRITICAL();
+        {
+            /* Remove the task from the ready, delayed or suspended list and
+             * from any event list, as vTaskDelete() does. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The next expected unblock time may have referred to the task. */
+            prvResetNextTaskUnblockTime();
+
+            /* Let the port release what it holds for the old context, as
+             * prvDeleteTCB() does, then build a new one on the same stack. */
+            portCLEAN_UP_TCB( pxTCB );
+
+            #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+                {
+                    #if ( portSTACK_GROWTH < 0 )
+                        {
+                            pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxStartOfStack, pxTCB->pxStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+                        }
+                    #else /* portSTACK_GROWTH */
+                        {
+                            pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxStartOfStack, pxTCB->pxEndOfStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+                        }
+                    #endif /* portSTACK_GROWTH */
+                }
+            #else /* portHAS_STACK_OVERFLOW_CHECKING */
+                {
+                    pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxStartOfStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+                }
+            #endif /* portHAS_STACK_OVERFLOW_CHECKING */
+
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                {
+                    memset( ( void * ) &( pxTCB->ulNotifiedValue[ 0 ] ), 0x00, sizeof( pxTCB->ulNotifiedValue ) );
+                    memset( ( void * ) &( pxTCB->ucNotifyState[ 0 ] ), 0x00, sizeof( pxTCB->ucNotifyState ) );
+                }
+            #endif
+
+            #if ( INCLUDE_xTaskAbortDelay == 1 )
+                {
+                    pxTCB->ucDelayAborted = pdFALSE;
+                }
+            #endif
+
+            prvAddTaskToReadyList( pxTCB );
+
+            /* A higher priority task may have just been made ready. */
+            #if P_TEST
+            if( pxTCB->uxPriority <= pxCurrentTCB->uxPriority )
+            #else
+            if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+            #endif
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* P_RESTART */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskDelayUntil == 1 )
 
     BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
@@ -1818,6 +2008,63 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
+#if P_EDF
+
+    void vTaskDeadlineSet( TaskHandle_t xTask,
+                           TickType_t xNewDeadline )
+    {
+        PRINT_FUNC_NAME;
+
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxTCB->xDeadline = xNewDeadline;
+            pxTCB->xHasDeadline = pdTRUE;
+
+            /* A task in the blocked or suspended state is placed by its
+             * deadline when it becomes ready.  A ready task is moved now. */
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+            {
+                /* The task stays in the same ready list, so it is never empty
+                 * in between and the top ready priority does not change. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                prvInsertTaskByDeadline( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), pxTCB );
+
+                /* Either the running task got a later deadline, or a task with
+                 * the running task's priority may now come before it.  Nothing
+                 * is switched before the scheduler is started. */
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    if( ( pxTCB == pxCurrentTCB ) || ( pxTCB->uxPriority == pxCurrentTCB->uxPriority ) )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* P_EDF */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
     void vTaskSuspend( TaskHandle_t xTaskToSuspend )
@@ -4165,6 +4412,43 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if P_EDF
+
+    static void prvInsertTaskByDeadline( List_t * const pxList,
+                                         TCB_t * const pxTCB )
+    {
+        ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+        ListItem_t * pxIterator;
+        TCB_t * pxOtherTCB;
+
+        listSET_LIST_ITEM_VALUE( pxNewListItem, pxTCB->xDeadline );
+
+        /* vListInsert() cannot be used as it compares the raw item values,
+         * which breaks when deadlines wrap around the tick count. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != ( ListItem_t * ) listGET_END_MARKER( pxList ); pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            pxOtherTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+            if( ( pxOtherTCB->xHasDeadline == pdFALSE ) || taskDEADLINE_IS_BEFORE( pxTCB->xDeadline, pxOtherTCB->xDeadline ) )
+            {
+                break;
+            }
+        }
+
+        /* Insert the new item in front of pxIterator. */
+        pxNewListItem->pxNext = pxIterator;
+        pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+        pxIterator->pxPrevious->pxNext = pxNewListItem;
+        pxIterator->pxPrevious = pxNewListItem;
+
+        pxNewListItem->pxContainer = pxList;
+
+        ( pxList->uxNumberOfItems )++;
+    }
+
+#endif /* P_EDF */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime( void )
 {
     if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
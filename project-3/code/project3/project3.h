@@ -1,25 +1,25 @@
-#ifndef PROJECT3_H_
-#define PROJECT3_H_
-
-#include <util/delay_basic.h>
-#include "scheduler.h"
-
-/* Struct */
-typedef struct TaskProperties
-{
-	TaskHandle_t xHandle;
-
-	const char xTaskName[8];
-	const TickType_t xPhaseTick;
-	const TickType_t xMaxExecTick;
-	const TickType_t xDeadlineTick;
-	const TickType_t xPeriodTick;
-
-	struct
-	{
-		TickType_t xRunTick;
-	} xParameters;
-
-} TaskProperties_t;
-
+#ifndef PROJECT3_H_
+#define PROJECT3_H_
+
+#include <util/delay_basic.h>
+#include "scheduler.h"
+
+/* Struct */
+typedef struct TaskProperties
+{
+	TaskHandle_t xHandle;
+
+	const char xTaskName[8];
+	const TickType_t xPhaseTick;
+	const TickType_t xMaxExecTick;
+	const TickType_t xDeadlineTick;
+	const TickType_t xPeriodTick;
+
+	struct
+	{
+		TickType_t xRunTick;
+	} xParameters;
+
+} TaskProperties_t;
+
 #endif
\ No newline at end of file
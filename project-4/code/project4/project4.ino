@@ -31,8 +31,8 @@ inline void RunCPU(TickType_t uxTicks)
 
 	while(uxTicks--)
 	{
-		// Runs the CPU for 15 ms at FCLK = 16Mhz; 15 ms is WatchDog Timer Interrupt
-		_delay_loop_2(60000);
+		// Runs the CPU for one tick, see schedDELAY_LOOPS_PER_TICK
+		_delay_loop_2(schedDELAY_LOOPS_PER_TICK);
 	}	
 }
 
@@ -112,9 +112,11 @@ void setup()
 {
 
 }
+/* Runs in the idle task, prints what PRINTF stored. */
 void loop() 
 {
-
+	vSchedulerProfileReport();
+	vSchedulerLogDrain();
 }
 
 int main( void )
@@ -172,14 +174,14 @@ int main( void )
 	/* Create Resource Handle */
 	R2 = xSchedulerCreateResource("R2");
 
-	/* Tell scheduler which tasks use the resource */
-	vSchedulerResourceUsedByTask(R1, &(xTaskProperties[0].xHandle));
-	vSchedulerResourceUsedByTask(R1, &(xTaskProperties[3].xHandle));
+	/* Tell scheduler which tasks use the resource, and for how many ticks */
+	vSchedulerResourceUsedByTask(R1, &(xTaskProperties[0].xHandle), 2);
+	vSchedulerResourceUsedByTask(R1, &(xTaskProperties[3].xHandle), 9);
 
-	/* Tell scheduler which tasks use the resource */
-	vSchedulerResourceUsedByTask(R2, &(xTaskProperties[1].xHandle));
-	vSchedulerResourceUsedByTask(R2, &(xTaskProperties[3].xHandle));
-	vSchedulerResourceUsedByTask(R2, &(xTaskProperties[4].xHandle));
+	/* Tell scheduler which tasks use the resource, and for how many ticks */
+	vSchedulerResourceUsedByTask(R2, &(xTaskProperties[1].xHandle), 2);
+	vSchedulerResourceUsedByTask(R2, &(xTaskProperties[3].xHandle), 3);
+	vSchedulerResourceUsedByTask(R2, &(xTaskProperties[4].xHandle), 4);
 
 	vSchedulerStart();
 
@@ -0,0 +1,72 @@
+/* PRINTF formats for schedLOG_TOKENIZED, the index of a format is the ID
+ * sent in its frames. Generated by final-project/host/logtoken -g from
+ *   scheduler.cpp project4.ino
+ * Regenerate it after changing a PRINTF format. */
+
+#ifndef LOG_TABLE_H_
+#define LOG_TABLE_H_
+
+static constexpr const char *pcSchedulerLogTable[] =
+{
+	"PROF unit: %s\n",
+	"PROF %s n=%lu min=%lu avg=%lu max=%lu\n",
+	"PROF %s <%lu: %u\n",
+	"PROF %s >=%lu: %u\n",
+	"\nFUNC: %s",
+	" -> TASK: %s, INIT RUN\n",
+	"TASK: %-2s\n",
+	"STAT: %-2s, ST:%04u, ET:%04u, RT:%02u, DT: %04u\n",
+	"\nFUNC: %s\n",
+	"---- Task Details ----\n",
+	"Name                : %s\n",
+	"Phase Tick          : %u\n",
+	"Max. Execution Tick : %u\n",
+	"Rel. Deadline Tick  : %u\n",
+	"Period Tick         : %u\n",
+	"Priority            : %d\n",
+	"----------------------\n\n",
+	"----Using RM Scheduling Algorithm----\n",
+	"----Using DM Scheduling Algorithm----\n",
+	"----Using Audsley OPA Algorithm----\n",
+	"-------------------------------------\n\n",
+	"----No feasible order, using DM----\n",
+	" Task : %s, Priority : %d, Tick : %d\n",
+	"-------------------------------------\n",
+	"FUNC: %s\n",
+	"----Blocking under OCPP, same bound as ICPP----\n",
+	"----Blocking under ICPP, same bound as OCPP----\n",
+	"Scheduler cost per job : %d\n",
+	" Task : %s, B : %lu, R : %lu, D : %lu\n",
+	" Task : %s, B : %lu, R > %lu, can miss its deadline\n",
+	"----Task set is not feasible----\n",
+	" -> TASK: %s @ T : %d\n",
+	"---- Scheduler Details ----\n",
+	"Priority     : %d\n",
+	"Overhead     : %d\n",
+	"---------------------------\n",
+	"Not started\n",
+	"----Using OCPP----\n",
+	"----Using ICPP----\n",
+	"---- Resource Details ----------\n",
+	"Name                           : %s\n",
+	"Priority Ceiling               : %d\n",
+	"Number Of Tasks Using Resource : %d\n",
+	"Tasks Utilizing Resource       : [ ",
+	"%s ",
+	"]\n",
+	"--------------------------------\n\n",
+	"%s Freed By %s\n",
+	" %s Blocked %s @ T : %d\n",
+	"%s Locked By %s |",
+	" SPC : %d @ T : %d\n",
+	"%s Denied To %s |",
+	"%s Locked By %s @ T : %d\n",
+	"%s Locked By %s\n",
+	"%s Unblocked %s @ T : %d\n",
+	"%s Freed By %s @ T : %d\n",
+	"TASK : %-2s, PRIORITY : %d\n",
+	"%s : CRITICAL SECTION START\n",
+	"%s : CRITICAL SECTION END\n"
+};
+
+#endif /* LOG_TABLE_H_ */
@@ -1,1365 +1,2683 @@
-#include "scheduler.h"
-
-#define schedUSE_TCB_ARRAY 1
-
-#define prvGetRCBFromHandle( pxHandle )    ( SchedRCB_t * ) ( pxHandle )
-
-/* Extended Task control block for managing periodic tasks within this library. */
-typedef struct xExtended_TCB
-{
-	TaskFunction_t pvTaskCode; 		/* Function pointer to the code that will be run periodically. */
-	const char *pcName; 			/* Name of the task. */
-	UBaseType_t uxStackDepth; 			/* Stack size of the task. */
-	void *pvParameters; 			/* Parameters to the task function. */
-	UBaseType_t uxPriority; 		/* Priority of the task. */
-	TaskHandle_t *pxTaskHandle;		/* Task handle for the task. */
-	TickType_t xReleaseTime;		/* Release time of the task. */
-	TickType_t xRelativeDeadline;	/* Relative deadline of the task. */
-	TickType_t xAbsoluteDeadline;	/* Absolute deadline of the task. */
-	TickType_t xPeriod;				/* Task period. */
-	TickType_t xLastWakeTime; 		/* Last time stamp when the task was running. */
-	TickType_t xMaxExecTime;		/* Worst-case execution time of the task. */
-	TickType_t xExecTime;			/* Current execution time of the task. */
-
-	BaseType_t xWorkIsDone; 		/* pdFALSE if the job is not finished, pdTRUE if the job is finished. */
-
-	#if( schedUSE_TCB_ARRAY == 1 )
-		BaseType_t xPriorityIsSet; 	/* pdTRUE if the priority is assigned. */
-		BaseType_t xInUse; 			/* pdFALSE if this extended TCB is empty. */
-	#endif
-
-	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
-		BaseType_t xExecutedOnce;	/* pdTRUE if the task has executed once. */
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-
-	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 || schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
-		TickType_t xAbsoluteUnblockTime; /* The task will be unblocked at this time if it is blocked by the scheduler task. */
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME || schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-
-	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
-		BaseType_t xSuspended; 		/* pdTRUE if the task is suspended. */
-		BaseType_t xMaxExecTimeExceeded; /* pdTRUE when execTime exceeds maxExecTime. */
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
-	
-	/* add if you need anything else */	
-	UBaseType_t uxActivePriority;
-	TaskHandle_t *pxBlockerTaskHandle;
-	BaseType_t xIsBlocked;  
-	UBaseType_t xHasResource;
-
-} SchedTCB_t;
-
-/************************************** RESOURCE ACCESS PROTOCOL DECLARATIONS ***********************************************/
-
-/* Resource Control Block */
-typedef struct xRCB
-{
-    const char *pcName; 			    /* Name of the resource. */
-
-    SchedTCB_t *pxHolderTCB;            /* Task handle that holds the lock. */
-
-	UBaseType_t uxPriorityCeiling;	    /* Priority ceiling of the resource. */
-
-	BaseType_t xIsLocked; 			    /* pdFALSE, if this resource is not locked. */
-
-	TaskHandle_t *pxUsedByTask[5];		/* Holds all the tasks handles that may use the resource */
-
-	BaseType_t xUsedByTaskCounter;      /* Number of tasks that may hold the resource */
-
-	BaseType_t xInUse = pdFALSE; 	    /* pdFALSE, if this RCB is empty. */
-
-} SchedRCB_t;
-
-/* Initializes the xSCArray */
-static void prvInitRCBArray( void );
-
-/* This function assigns priority ceiling to
- * the resources based on tasks' requirement. 
- * */
-static void prvSetPriorityCeilingToResources( void );
-
-/* This function updates system priority ceiling 
- * to  the maximum priority ceiling among 
- * all the semaphores currently locked by tasks 
- * other than the one in execution. 
- * */
-static void prvUpdateSystemPriorityCeiling( void );
-
-static void prvFreeAllResourcesHeldByTask( SchedTCB_t *pxTCB );
-
-
-
-static BaseType_t prvCheckResourcesPriorityCeilingHeldByTask( SchedTCB_t *pxTaskHandle );
-
-static void prvLockResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
-
-static void prvDenyResource(SchedTCB_t *pxBlockedTCB, SchedTCB_t *pxTCB);
-
-static void prvBlockTask(SchedTCB_t *pxTCB);
-
-static void prvResourceWait(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
-
-
-
-static void prvFreeResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
-
-static void prvUpdateTaskPriority(SchedTCB_t *pxTCB);
-
-static void prvUnblockTasks( SchedTCB_t *pxTCB );
-
-static void prvResourceSignal(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
-
-
-
-/* Array for RCBs. */
-static SchedRCB_t xRCBArray[5] = {};
-
-/* Counter for number of resources. */
-static BaseType_t xResourceCounter = 0;
-
-/* The current system priority ceiling value */
-static UBaseType_t uxSystemPriorityCeiling = 0;
-
-/* Pointer to the current system priority ceiling RCB */
-static SchedRCB_t *pxSystemPriorityCeilingPointer = NULL;
-
-/****************************************************************************************************************************/
-
-#if( schedUSE_TCB_ARRAY == 1 )
-	static BaseType_t prvGetTCBIndexFromHandle( TaskHandle_t xTaskHandle );
-	static SchedTCB_t *prvGetTCBFromHandle( TaskHandle_t xTaskHandle );
-	static void prvInitTCBArray( void );
-	/* Find index for an empty entry in xTCBArray. Return -1 if there is no empty entry. */
-	static BaseType_t prvFindEmptyElementIndexTCB( void );
-	/* Remove a pointer to extended TCB from xTCBArray. */
-	static void prvDeleteTCBFromArray( BaseType_t xIndex );
-#endif /* schedUSE_TCB_ARRAY */
-
-static TickType_t xSystemStartTime = 0;
-
-static void prvPeriodicTaskCode( void *pvParameters );
-static void prvCreateAllTasks( void );
-
-
-#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-	static void prvSetFixedPriorities( void );	
-#endif /* schedSCHEDULING_POLICY_RMS */
-
-#if( schedUSE_SCHEDULER_TASK == 1 )
-	static void prvSchedulerCheckTimingError( TickType_t xTickCount, SchedTCB_t *pxTCB );
-	static void prvSchedulerFunction( void );
-	static void prvCreateSchedulerTask( void );
-	static void prvWakeScheduler( void );
-
-	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
-		static void prvPeriodicTaskRecreate( SchedTCB_t *pxTCB );
-		static void prvDeadlineMissedHook( SchedTCB_t *pxTCB, TickType_t xTickCount );
-		static void prvCheckDeadline( SchedTCB_t *pxTCB, TickType_t xTickCount );				
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-
-	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
-		static void prvExecTimeExceedHook( TickType_t xTickCount, SchedTCB_t *pxCurrentTask );
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
-	
-#endif /* schedUSE_SCHEDULER_TASK */
-
-
-
-#if( schedUSE_TCB_ARRAY == 1 )
-	/* Array for extended TCBs. */
-	static SchedTCB_t xTCBArray[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { 0 };
-	/* Counter for number of periodic tasks. */
-	static BaseType_t xTaskCounter = 0;
-#endif /* schedUSE_TCB_ARRAY */
-
-#if( schedUSE_SCHEDULER_TASK )
-	static TickType_t xSchedulerWakeCounter = 0; /* useful. why? */
-	static TaskHandle_t xSchedulerHandle = NULL; /* useful. why? */
-#endif /* schedUSE_SCHEDULER_TASK */
-
-
-#if( schedUSE_TCB_ARRAY == 1 )
-	/* Returns index position in xTCBArray of TCB with same task handle as parameter. */
-	static BaseType_t prvGetTCBIndexFromHandle( TaskHandle_t xTaskHandle )
-	{
-		static BaseType_t xIndex = 0;
-		BaseType_t xIterator;
-
-		for( xIterator = 0; xIterator < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIterator++ )
-		{
-		
-			if( pdTRUE == xTCBArray[ xIndex ].xInUse && *xTCBArray[ xIndex ].pxTaskHandle == xTaskHandle )
-			{
-				return xIndex;
-			}
-		
-			xIndex++;
-			if( schedMAX_NUMBER_OF_PERIODIC_TASKS == xIndex )
-			{
-				xIndex = 0;
-			}
-		}
-		return -1;
-	}
-
-	static SchedTCB_t *prvGetTCBFromHandle( TaskHandle_t xTaskHandle )
-	{
-		static BaseType_t xIndex = 0;
-		BaseType_t xIterator;
-
-		for( xIterator = 0; xIterator < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIterator++ )
-		{
-		
-			if( pdTRUE == xTCBArray[ xIndex ].xInUse && *xTCBArray[ xIndex ].pxTaskHandle == xTaskHandle )
-			{
-				return &(xTCBArray[ xIndex ]);
-			}
-		
-			xIndex++;
-			if( schedMAX_NUMBER_OF_PERIODIC_TASKS == xIndex )
-			{
-				xIndex = 0;
-			}
-		}
-
-		return NULL;
-	}
-
-	/* Initializes xTCBArray. */
-	static void prvInitTCBArray( void )
-	{
-		UBaseType_t uxIndex;
-		for( uxIndex = 0; uxIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; uxIndex++)
-		{
-			xTCBArray[ uxIndex ].xInUse = pdFALSE;
-		}
-	}
-
-	/* Find index for an empty entry in xTCBArray. Returns -1 if there is no empty entry. */
-	static BaseType_t prvFindEmptyElementIndexTCB( void )
-	{
-		/* your implementation goes here */
-		BaseType_t xIndex = -1;
-		BaseType_t xIterator;
-
-		for (xIterator = 0; xIterator < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIterator++ )
-		{
-			if (pdFALSE == xTCBArray[xIterator].xInUse)
-			{
-				xIndex = xIterator;
-				break;
-			}
-		}
-
-		return xIndex;
-	}
-
-	/* Remove a pointer to extended TCB from xTCBArray. */
-	static void prvDeleteTCBFromArray( BaseType_t xIndex )
-	{
-		configASSERT(0 <= xIndex && xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS);
-		configASSERT(pdTRUE == xTCBArray[xIndex].xInUse);
-
-		if (pdTRUE == xTCBArray[xIndex].xInUse)
-		{
-			xTCBArray[xIndex].xInUse = pdFALSE;
-			xTaskCounter--;
-		}
-	}
-	
-#endif /* schedUSE_TCB_ARRAY */
-
-
-/* The whole function code that is executed by every periodic task.
- * This function wraps the task code specified by the user. */
-static void prvPeriodicTaskCode( void *pvParameters )
-{
-	TickType_t xStartTick, xEndTick;
-	BaseType_t xIndex;
-	SchedTCB_t *pxThisTask;	
-	TaskHandle_t xCurrentTaskHandle = xTaskGetCurrentTaskHandle();  
-	
-	/* Check the handle is not NULL. */
-	configASSERT(NULL != xCurrentTaskHandle);
-	xIndex = prvGetTCBIndexFromHandle(xCurrentTaskHandle);
-	configASSERT(-1 != xIndex);
-	pxThisTask = &xTCBArray[xIndex];
-    
-	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
-        pxThisTask->xExecutedOnce = pdTRUE;
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-    
-	PRINTF("\nFUNC: %s", __func__);
-	PRINTF(" -> TASK: %s, INIT RUN\n", pxThisTask->pcName);
-
-	if( 0 == pxThisTask->xReleaseTime )
-	{
-		pxThisTask->xLastWakeTime = xSystemStartTime;
-	}
-	else
-	{
-		xTaskDelayUntil(&pxThisTask->xLastWakeTime, pxThisTask->xReleaseTime);
-	}
-
-	for( ; ; )
-	{	
-		//PRINTF("TASK: %-2s\n",pxThisTask->pcName);
-			
-		pxThisTask->xWorkIsDone = pdFALSE;
-
-		xStartTick = xTaskGetTickCount();		
-		pxThisTask->pvTaskCode( pvParameters );
-		xEndTick = xTaskGetTickCount();
-   
-        pxThisTask->xWorkIsDone = pdTRUE;
-		pxThisTask->xExecTime = 0;
-
-		PRINTF("STAT: %-2s, ST:%04u, ET:%04u, RT:%02u, DT: %04u\n", pxThisTask->pcName, xStartTick, xEndTick, (xEndTick - xStartTick), pxThisTask->xAbsoluteDeadline);
-	
-		xTaskDelayUntil(&pxThisTask->xLastWakeTime, pxThisTask->xPeriod );
-	}
-}
-
-/* Creates a periodic task. */
-void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, UBaseType_t uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
-		TaskHandle_t *pxCreatedTask, TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-
-	taskENTER_CRITICAL();
-	SchedTCB_t *pxNewTCB;
-	
-	#if( schedUSE_TCB_ARRAY == 1 )
-		BaseType_t xIndex = prvFindEmptyElementIndexTCB();
-		configASSERT( xTaskCounter < schedMAX_NUMBER_OF_PERIODIC_TASKS );
-		configASSERT( xIndex != -1 );
-		pxNewTCB = &xTCBArray[ xIndex ];	
-	#endif /* schedUSE_TCB_ARRAY */
-
-	/* Intialize item. */
-		
-	pxNewTCB->pvTaskCode = pvTaskCode;
-	pxNewTCB->pcName = pcName;
-	pxNewTCB->uxStackDepth = uxStackDepth;
-	pxNewTCB->pvParameters = pvParameters;
-	pxNewTCB->uxPriority = uxPriority;
-	pxNewTCB->pxTaskHandle = pxCreatedTask;
-	pxNewTCB->xReleaseTime = xPhaseTick;
-	pxNewTCB->xPeriod = xPeriodTick;
-	
-    /* Populate the rest */
-  	pxNewTCB->xMaxExecTime = xMaxExecTimeTick;
-  	pxNewTCB->xRelativeDeadline = xDeadlineTick;
-	pxNewTCB->xAbsoluteDeadline = pxNewTCB->xRelativeDeadline + pxNewTCB->xReleaseTime + xSystemStartTime;
-  	pxNewTCB->xWorkIsDone = pdTRUE;
-  	pxNewTCB->xExecTime = 0;
-
-	#if( schedUSE_TCB_ARRAY == 1 )
-		pxNewTCB->xInUse = pdTRUE;
-	#endif /* schedUSE_TCB_ARRAY */
-	
-	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-        pxNewTCB->xPriorityIsSet = pdFALSE;
-	#endif /* schedSCHEDULING_POLICY */
-	
-	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
-        pxNewTCB->xExecutedOnce = pdFALSE;
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-	
-	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
-        pxNewTCB->xSuspended = pdFALSE;
-        pxNewTCB->xMaxExecTimeExceeded = pdFALSE;
-	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */	
-
-	#if( schedUSE_TCB_ARRAY == 1 )
-		xTaskCounter++;	
-	#endif /* schedUSE_TCB_SORTED_LIST */
-	
-	/* add if you need anything else */
-	pxNewTCB->uxActivePriority = uxPriority;
-	pxNewTCB->pxBlockerTaskHandle = NULL;
-	pxNewTCB->xIsBlocked = pdFALSE;
-	pxNewTCB->xHasResource = 0;
-
-	PRINTF("---- Task Details ----\n");
-	PRINTF("Name                : %s\n", pxNewTCB->pcName);
-	PRINTF("Phase Tick          : %u\n", pxNewTCB->xReleaseTime);
-	PRINTF("Max. Execution Tick : %u\n", pxNewTCB->xMaxExecTime);
-	PRINTF("Rel. Deadline Tick  : %u\n", pxNewTCB->xRelativeDeadline);
-	PRINTF("Period Tick         : %u\n", pxNewTCB->xPeriod);
-	PRINTF("Priority            : %d\n", pxNewTCB->uxPriority);
-	PRINTF("----------------------\n\n");
-
-	taskEXIT_CRITICAL();
-}
-
-/* Deletes a periodic task. */
-void vSchedulerPeriodicTaskDelete( TaskHandle_t xTaskHandle )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-	
-	BaseType_t xIndex;
-
-	if (NULL != xTaskHandle)
-	{
-		xIndex = prvGetTCBIndexFromHandle(xTaskHandle);
-	}
-	else
-	{
-		xTaskHandle = xTaskGetCurrentTaskHandle();
-		xIndex = prvGetTCBIndexFromHandle(xTaskHandle);
-	}
-	
-	configASSERT(-1 != xIndex);
-
-	prvDeleteTCBFromArray(xIndex);
-	vTaskDelete(xTaskHandle);
-}
-
-/* Creates all periodic tasks stored in TCB array, or TCB list. */
-static void prvCreateAllTasks( void )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-	
-	SchedTCB_t *pxTCB;
-
-	#if( schedUSE_TCB_ARRAY == 1 )
-		BaseType_t xIndex;
-		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
-		{
-			configASSERT( pdTRUE == xTCBArray[ xIndex ].xInUse );
-			pxTCB = &xTCBArray[ xIndex ];
-
-			BaseType_t xReturnValue = xTaskCreate(prvPeriodicTaskCode, pxTCB->pcName, 
-												  pxTCB->uxStackDepth, pxTCB->pvParameters,
-												  pxTCB->uxPriority, pxTCB->pxTaskHandle);
-
-		}	
-	#endif /* schedUSE_TCB_ARRAY */
-}
-
-#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-
-	/* Initiazes fixed priorities of all periodic tasks with respect to RMS policy. */
-static void prvSetFixedPriorities( void )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-
-	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
-		PRINTF("----Using RM Scheduling Algorithm----\n");
-	#elif( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS ) 
-		PRINTF("----Using DM Scheduling Algorithm----\n");
-	#endif
-
-	BaseType_t xIter, xIndex;
-	TickType_t xShortest, xPreviousShortest=0;
-	SchedTCB_t *pxShortestTaskPointer, *pxTCB;
-
-	#if( schedUSE_SCHEDULER_TASK == 1 )
-		BaseType_t xHighestPriority = schedSCHEDULER_PRIORITY; 
-	#else
-		BaseType_t xHighestPriority = configMAX_PRIORITIES;
-	#endif /* schedUSE_SCHEDULER_TASK */
-
-	for( xIter = 0; xIter < xTaskCounter; xIter++ )
-	{
-		xShortest = portMAX_DELAY;
-
-		/* search for shortest period */
-		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
-		{
-			pxTCB = &xTCBArray[xIndex];
-			configASSERT(pdTRUE == pxTCB->xInUse);
-
-			if (pdFALSE == pxTCB->xPriorityIsSet)
-			{
-				#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
-					if (pxTCB->xPeriod <= xShortest)
-					{
-						xShortest = pxTCB->xPeriod;
-						pxShortestTaskPointer = pxTCB;
-					}
-				#elif( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-					if (pxTCB->xRelativeDeadline <= xShortest)
-					{
-						xShortest = pxTCB->xRelativeDeadline;
-						pxShortestTaskPointer = pxTCB;
-					}
-				#endif /* schedSCHEDULING_POLICY */
-			}
-		}
-		
-		/* set highest priority to task with xShortest period (the highest priority is configMAX_PRIORITIES-1) */		
-		if (xShortest != xPreviousShortest)
-		{
-			xHighestPriority--;
-		}
-
-		configASSERT(tskIDLE_PRIORITY < xHighestPriority);
-
-		pxShortestTaskPointer->uxPriority = xHighestPriority;
-		pxShortestTaskPointer->uxActivePriority = xHighestPriority;
-		pxShortestTaskPointer->xPriorityIsSet = pdTRUE;
-
-		xPreviousShortest = xShortest;
-	
-		PRINTF(" Task : %s, Priority : %d, Tick : %d\n", 
-		pxShortestTaskPointer->pcName, pxShortestTaskPointer->uxPriority, xShortest);
-	
-	}
-	PRINTF("-------------------------------------\n");
-}
-#endif /* schedSCHEDULING_POLICY */
-
-
-#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
-
-	/* Recreates a deleted task that still has its information left in the task array (or list). */
-	static void prvPeriodicTaskRecreate( SchedTCB_t *pxTCB )
-	{
-		BaseType_t xReturnValue = xTaskCreate(prvPeriodicTaskCode, pxTCB->pcName, 
-											  pxTCB->uxStackDepth, pxTCB->pvParameters,
-		 								      pxTCB->uxPriority, pxTCB->pxTaskHandle);
-				                      		
-		if( pdPASS == xReturnValue )
-		{
-			pxTCB->xExecutedOnce = pdFALSE;		
-			pxTCB->xSuspended = pdFALSE;
-			pxTCB->xMaxExecTimeExceeded = pdFALSE;
-
-			pxTCB->uxActivePriority = pxTCB->uxPriority;
-			pxTCB->pxBlockerTaskHandle = NULL;
-			pxTCB->xIsBlocked = pdFALSE;
-			pxTCB->xHasResource = 0;
-		}
-		else
-		{
-			configASSERT(pdFAIL);
-		}
-	}
-
-	/* Called when a deadline of a periodic task is missed.
-	 * Deletes the periodic task that has missed it's deadline and recreate it.
-	 * The periodic task is released during next period. */
-	static void prvDeadlineMissedHook( SchedTCB_t *pxTCB, TickType_t xTickCount )
-	{
-		PRINTF("\nFUNC: %s", __func__);
-		PRINTF(" -> TASK: %s @ T : %d\n", pxTCB->pcName, xTickCount);
-
-		/* Free up all resources held by task */
-		prvFreeAllResourcesHeldByTask(pxTCB);
-
-		/* Delete the pxTask and recreate it. */
-		vTaskDelete(*(pxTCB->pxTaskHandle));
-		pxTCB->xExecTime = 0;
-		prvPeriodicTaskRecreate(pxTCB);	
-		
-		pxTCB->xReleaseTime = pxTCB->xLastWakeTime + pxTCB->xPeriod;
-		pxTCB->xAbsoluteDeadline = pxTCB->xLastWakeTime + pxTCB->xPeriod + pxTCB->xRelativeDeadline;
-	}
-
-	/* Checks whether given task has missed deadline or not. */
-	static void prvCheckDeadline( SchedTCB_t *pxTCB, TickType_t xTickCount )
-	{   
-		pxTCB->xAbsoluteDeadline = pxTCB->xLastWakeTime + pxTCB->xRelativeDeadline;
-
-		if (( signed ) ( pxTCB->xAbsoluteDeadline - xTickCount ) < 0)
-		{
-			prvDeadlineMissedHook( pxTCB, xTickCount );
-		}	
-	}	
-#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-
-
-#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
-
-	/* Called if a periodic task has exceeded its worst-case execution time.
-	 * The periodic task is blocked until next period. A context switch to
-	 * the scheduler task occur to block the periodic task. */
-	static void prvExecTimeExceedHook( TickType_t xTickCount, SchedTCB_t *pxCurrentTask )
-	{
-		PRINTF("\nFUNC: %s", __func__);
-		PRINTF(" -> TASK: %s @ T : %d\n", pxCurrentTask->pcName, xTickCount);
-
-        pxCurrentTask->xMaxExecTimeExceeded = pdTRUE;
-        /* Is not suspended yet, but will be suspended by the scheduler later. */
-        pxCurrentTask->xSuspended = pdTRUE;
-        pxCurrentTask->xAbsoluteUnblockTime = pxCurrentTask->xLastWakeTime + pxCurrentTask->xPeriod;
-        pxCurrentTask->xExecTime = 0;
-
-        BaseType_t xHigherPriorityTaskWoken;
-        vTaskNotifyGiveFromISR( xSchedulerHandle, &xHigherPriorityTaskWoken );
-        xTaskResumeFromISR(xSchedulerHandle);
-	}
-#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
-
-
-#if( schedUSE_SCHEDULER_TASK == 1 )
-	/* Called by the scheduler task. Checks all tasks for any enabled
-	 * Timing Error Detection feature. */
-	static void prvSchedulerCheckTimingError( TickType_t xTickCount, SchedTCB_t *pxTCB )
-	{
-
-		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )						
-			if ((pdTRUE == pxTCB->xWorkIsDone) && (( signed ) ( xTickCount - pxTCB->xLastWakeTime ) > 0))
-			{
-				pxTCB->xWorkIsDone = pdFALSE;
-			}
-
-			/* check if task missed deadline */
-			if ((pdTRUE == pxTCB->xExecutedOnce) && (pdFALSE == pxTCB->xWorkIsDone ))
-			{
-				prvCheckDeadline(pxTCB, xTickCount);
-			}						
-		#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-		
-
-		#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
-        if( pdTRUE == pxTCB->xMaxExecTimeExceeded )
-        {
-			/* Free up all resources held by task */
-			prvFreeAllResourcesHeldByTask(pxTCB);
-
-            pxTCB->xMaxExecTimeExceeded = pdFALSE;
-            vTaskSuspend( *pxTCB->pxTaskHandle );
-        }
-        if( pdTRUE == pxTCB->xSuspended )
-        {
-            if( ( signed ) ( pxTCB->xAbsoluteUnblockTime - xTickCount ) <= 0 )
-            {
-                pxTCB->xSuspended = pdFALSE;
-                pxTCB->xLastWakeTime = xTickCount;
-                vTaskResume( *pxTCB->pxTaskHandle );
-            }
-        }
-		#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
-
-		return;
-	}
-
-	/* Function code for the scheduler task. */
-	static void prvSchedulerFunction( void *pvParameters )
-	{
-		for( ; ; )
-		{ 
-     		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
-				TickType_t xTickCount = xTaskGetTickCount();
-				UBaseType_t xIndex;
-        		SchedTCB_t *pxTCB;
-        		
-				for (xIndex = 0; xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex++)
-				{
-					pxTCB = &xTCBArray[xIndex];
-					/* Only check tasks which are in use */
-					if (pdTRUE == pxTCB->xInUse)
-					{
-						prvSchedulerCheckTimingError(xTickCount, pxTCB);
-					}
-				}
-			#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
-
-			#if (schedOVERHEAD == 1)
-				TickType_t xTicks = schedOVERHEAD_TICKS;
-				while(xTicks--)
-				{
-					// Runs the CPU for 15 ms at FCLK = 16Mhz; 15 ms is WatchDog Timer Interrupt
-					_delay_loop_2(60000);
-				}
-			#endif
-
-			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
-		}
-	}
-
-	/* Creates the scheduler task. */
-	static void prvCreateSchedulerTask( void )
-	{
-		PRINTF("\nFUNC: %s\n", __func__);
-		PRINTF("---- Scheduler Details ----\n");
-		PRINTF("Period Tick  : %d\n", schedSCHEDULER_TASK_PERIOD);
-		PRINTF("Priority     : %d\n", schedSCHEDULER_PRIORITY);
-		PRINTF("Overhead     : %d\n", schedOVERHEAD);
-		PRINTF("---------------------------\n");
-
-		xTaskCreate( (TaskFunction_t) prvSchedulerFunction, "Scheduler", schedSCHEDULER_TASK_STACK_SIZE, NULL, schedSCHEDULER_PRIORITY, &xSchedulerHandle );                             
-	}
-#endif /* schedUSE_SCHEDULER_TASK */
-
-
-#if( schedUSE_SCHEDULER_TASK == 1 )
-	/* Wakes up (context switches to) the scheduler task. */
-	static void prvWakeScheduler( void )
-	{
-		BaseType_t xHigherPriorityTaskWoken;
-		vTaskNotifyGiveFromISR( xSchedulerHandle, &xHigherPriorityTaskWoken );
-		xTaskResumeFromISR(xSchedulerHandle);  
-	}
-
-	/* Called every software tick. */
-	// In FreeRTOSConfig.h,
-	// Enable configUSE_TICK_HOOK
-	// Enable INCLUDE_xTaskGetIdleTaskHandle
-	// Enable INCLUDE_xTaskGetCurrentTaskHandle
-	void vApplicationTickHook( void )
-	{    
-		TickType_t xStartTick, xEndTick;
-
-		SchedTCB_t *pxCurrentTask;		
-		TaskHandle_t xCurrentTaskHandle = xTaskGetCurrentTaskHandle();		
-        UBaseType_t flag = 0;
-        BaseType_t xIndex;
-		BaseType_t prioCurrentTask = uxTaskPriorityGet(xCurrentTaskHandle);
-
-		for(xIndex = 0; xIndex < xTaskCounter ; xIndex++){
-			pxCurrentTask = &xTCBArray[xIndex];
-			if(pxCurrentTask -> uxPriority == prioCurrentTask){
-				flag = 1;
-				break;
-			}
-		}
-		
-		if( xCurrentTaskHandle != xSchedulerHandle && xCurrentTaskHandle != xTaskGetIdleTaskHandle() && flag == 1)
-		{
-			pxCurrentTask->xExecTime++;     
-     
-			#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
-            if( pxCurrentTask->xMaxExecTime <= pxCurrentTask->xExecTime )
-            {
-                if( pdFALSE == pxCurrentTask->xMaxExecTimeExceeded )
-                {
-                    if( pdFALSE == pxCurrentTask->xSuspended )
-                    {
-                        prvExecTimeExceedHook( xTaskGetTickCountFromISR(), pxCurrentTask );
-                    }
-                }
-            }
-			#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
-		}
-
-		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )    
-			xSchedulerWakeCounter++;      
-			if( xSchedulerWakeCounter == schedSCHEDULER_TASK_PERIOD )
-			{
-				xSchedulerWakeCounter = 0;        
-				prvWakeScheduler();
-			}
-		#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
-	}
-#endif /* schedUSE_SCHEDULER_TASK */
-
-/* This function must be called before any other function call from this module. */
-void vSchedulerInit( void )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-
-	#if( schedUSE_TCB_ARRAY == 1 )
-		prvInitTCBArray();
-	#endif /* schedUSE_TCB_ARRAY */
-
-	prvInitRCBArray();
-}
-
-
-/* Starts scheduling tasks. All periodic tasks (including polling server) must
- * have been created with API function before calling this function. */
-void vSchedulerStart( void )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-
-	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-		prvSetFixedPriorities();	
-	#endif /* schedSCHEDULING_POLICY */
-
-	#if( schedUSE_SCHEDULER_TASK == 1 )
-		prvCreateSchedulerTask();
-	#endif /* schedUSE_SCHEDULER_TASK */
-
-	prvCreateAllTasks();
-
-	prvSetPriorityCeilingToResources();
-
-	xSystemStartTime = xTaskGetTickCount();
-	
-	vTaskStartScheduler();
-}
-
-/************************************** RESOURCE ACCESS PROTOCOL DEFINITIONS ***********************************************/
-
-static void prvInitRCBArray( void )
-{
- 	UBaseType_t uxResourceIndex;
-	for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
-	{
-		xRCBArray[ uxResourceIndex ].xInUse = pdFALSE;
-	}   
-}
-
-static void prvSetPriorityCeilingToResources( void )
-{
-	#if ( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP )
-		PRINTF("----Using OCPP----\n");
-	#elif ( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_ICPP ) 
-		PRINTF("----Using ICPP----\n");
-	#endif
-
-	PRINTF("\nFUNC: %s\n", __func__);
-
-	UBaseType_t uxResourceIndex;
-	UBaseType_t uxTaskIndex;
-	UBaseType_t uxPriorityCeiling;
-
-	SchedRCB_t *pxRCB;
-
-	for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
-	{
-		/* Check if resource is in use */
-		if ( pdTRUE == xRCBArray[ uxResourceIndex ].xInUse )
-		{ 
-			/* Start with lowest priority */
-			uxPriorityCeiling = tskIDLE_PRIORITY;
-
-			pxRCB = &xRCBArray[ uxResourceIndex ];
-
-			/* Get task with highest priority from xUsedByTask Array */
-			for( uxTaskIndex = 0; uxTaskIndex < pxRCB->xUsedByTaskCounter ; uxTaskIndex++)
-			{
-				/* Check if priority is greater than current priority ceiling */
-				if ( uxPriorityCeiling < uxTaskPriorityGet(*(pxRCB->pxUsedByTask[ uxTaskIndex ])) )
-				{
-					uxPriorityCeiling = uxTaskPriorityGet(*(pxRCB->pxUsedByTask[ uxTaskIndex ]));
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
-
-			/* Assign highest priority to the resource */
-			pxRCB->uxPriorityCeiling = uxPriorityCeiling;
-
-			#if DEBUG
-				PRINTF("---- Resource Details ----------\n");
-				PRINTF("Name                           : %s\n", pxRCB->pcName);
-				PRINTF("Priority Ceiling               : %d\n", pxRCB->uxPriorityCeiling);
-				PRINTF("Number Of Tasks Using Resource : %d\n", pxRCB->xUsedByTaskCounter);
-				PRINTF("Tasks Utilizing Resource       : [ ");
-				for( uxTaskIndex = 0; uxTaskIndex < pxRCB->xUsedByTaskCounter ; uxTaskIndex++)
-				{
-					PRINTF("%s ", pcTaskGetName(*(pxRCB->pxUsedByTask[ uxTaskIndex ])));
-				}
-				PRINTF("]\n");
-				PRINTF("--------------------------------\n\n");
-			#endif
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-	}
-}
-
-static void prvUpdateSystemPriorityCeiling( void )
-{
-	UBaseType_t uxResourceIndex;
-
-	SchedRCB_t *pxRCB;
-
-	UBaseType_t uxMaxPriorityCeiling = tskIDLE_PRIORITY;
-
-	SchedRCB_t *uxMaxPriorityCeilingRCB = NULL;
-
-	for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
-	{
-		/* Check if resource is in use */
-		if ( pdTRUE == xRCBArray[ uxResourceIndex ].xInUse )
-		{ 
-			pxRCB = &xRCBArray[ uxResourceIndex ];
-
-			/* Check if resource is locked */
-			if ( pdTRUE == pxRCB->xIsLocked )
-			{
-				/* Check for priority ceiling */
-				if ( uxMaxPriorityCeiling < pxRCB->uxPriorityCeiling )
-				{
-					uxMaxPriorityCeiling = pxRCB->uxPriorityCeiling;
-					uxMaxPriorityCeilingRCB = pxRCB;
-
-				}			
-				else
-				{
-					mtCOVERAGE_TEST_MARKER()
-				}
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER()
-			}
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER()
-		}
-	}
-
-	uxSystemPriorityCeiling        = uxMaxPriorityCeiling;
-	pxSystemPriorityCeilingPointer = uxMaxPriorityCeilingRCB;
-
-}
-
-static void prvFreeAllResourcesHeldByTask( SchedTCB_t *pxTCB )
-{
-	UBaseType_t uxResourceIndex;
-
-	if(pxTCB->xHasResource)
-	{
-		vTaskSuspendAll();
-
-		for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
-		{
-			/* Check if resource is in use */
-			if ( pdTRUE == xRCBArray[ uxResourceIndex ].xInUse )
-			{
-				/* Check if resource is locked */
-				if ( pdTRUE == xRCBArray[ uxResourceIndex ].xIsLocked )
-				{
-					/* Check if given task has locked the resource */
-					if ( pxTCB == xRCBArray[ uxResourceIndex ].pxHolderTCB )
-					{
-						configASSERT( *(pxRCB->pxHolderTCB->pxTaskHandle) == *(pxTCB->pxTaskHandle) )
-
-						PRINTF("%s Freed By %s\n", xRCBArray[ uxResourceIndex ].pcName, pxTCB->pcName);
-
-						prvFreeResource(&(xRCBArray[ uxResourceIndex ]), pxTCB);
-						prvUnblockTasks(pxTCB);
-
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER()
-					}
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER()
-				}
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER()
-			}
-		}
-
-		xTaskResumeAll();	
-
-		prvUpdateSystemPriorityCeiling();
-	}
-}
-
-
-
-static BaseType_t prvCheckResourcesPriorityCeilingHeldByTask( SchedTCB_t *pxTCB )
-{
-	UBaseType_t uxResourceIndex;
-	BaseType_t  xFlag = pdFALSE;
-
-	for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
-	{
-		/* Check if resource is in use */
-		if ( pdTRUE == xRCBArray[ uxResourceIndex ].xInUse )
-		{
-			/* Check if resource is locked */
-			if ( pdTRUE == xRCBArray[ uxResourceIndex ].xIsLocked )
-			{
-				/* Check if given task has locked the resource */
-				if ( pxTCB == xRCBArray[ uxResourceIndex ].pxHolderTCB )
-				{
-					/* Check if priority ceiling is equal to system ceiling priority */
-					if ( uxSystemPriorityCeiling == xRCBArray[ uxResourceIndex ].uxPriorityCeiling )
-					{
-						xFlag = pdTRUE;
-						break;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER()
-					}
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER()
-				}
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER()
-			}
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER()
-		}
-	}
-
-	return xFlag;
-}
-
-static void prvLockResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
-{
-	taskENTER_CRITICAL();
-
-	pxRCB->xIsLocked    = pdTRUE;
-	pxRCB->pxHolderTCB  = pxTCB;
-
-	pxTCB->xHasResource++;
-
-	taskEXIT_CRITICAL();
-}
-
-static void prvDenyResource(SchedTCB_t *pxBlockedTCB, SchedTCB_t *pxTCB)
-{
-	PRINTF(" %s Blocked %s @ T : %d\n", pxBlockedTCB->pcName, pxTCB->pcName, xTaskGetTickCount());
-
-	taskENTER_CRITICAL();
-
-	pxBlockedTCB->xIsBlocked          = pdTRUE;
-	pxBlockedTCB->pxBlockerTaskHandle = pxTCB->pxTaskHandle;
-
-	#if( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP)
-		pxTCB->uxActivePriority = pxBlockedTCB->uxPriority;
-		vTaskPrioritySet(*(pxTCB->pxTaskHandle), pxTCB->uxActivePriority);
-	#endif
-
-	taskEXIT_CRITICAL();
-}
-
-static void prvBlockTask(SchedTCB_t *pxTCB)
-{
-	do 
-	{
-		taskYIELD();
-	} while ( pxTCB->xIsBlocked );
-}
-
-static void prvResourceWait(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
-{
-	#if( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP)
-		for ( ; ; )
-		{
-			PRINTF("\nFUNC: %s\n", __func__);
-
-			/* Check if a resource is free */
-			if (pdFALSE == pxRCB->xIsLocked)
-			{
-				/* Check if task priority is strictly greater than system priority ceiling */
-				if ( pxTCB->uxActivePriority > uxSystemPriorityCeiling )
-				{
-					prvLockResource(pxRCB, pxTCB);
-					prvUpdateSystemPriorityCeiling();
-
-					PRINTF("%s Locked By %s |", pxRCB->pcName, pxTCB->pcName);
-					PRINTF(" SPC : %d @ T : %d\n", uxSystemPriorityCeiling, xTaskGetTickCount());
-
-					return;
-				}
-				else
-				{
-					/* Check if task is holding any resource with priority equal to system priority ceiling */
-					if ( prvCheckResourcesPriorityCeilingHeldByTask(pxTCB) )
-					{
-
-						prvLockResource(pxRCB, pxTCB);
-						prvUpdateSystemPriorityCeiling();
-
-						PRINTF("%s Locked By %s |", pxRCB->pcName, pxTCB->pcName);
-						PRINTF(" SPC : %d @ T : %d\n", uxSystemPriorityCeiling, xTaskGetTickCount());
-
-						return;
-					}
-					else
-					{
-						PRINTF("%s Denied To %s |", pxRCB->pcName, pxTCB->pcName);
-
-						prvDenyResource(pxTCB, pxSystemPriorityCeilingPointer->pxHolderTCB);
-						prvBlockTask(pxTCB);
-					}
-				}
-			}
-			else
-			{
-				PRINTF("%s Denied To %s |", pxRCB->pcName, pxTCB->pcName);
-				
-				prvDenyResource(pxTCB, pxRCB->pxHolderTCB);
-				prvBlockTask(pxTCB);
-			}
-		}
-	#elif( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_ICPP)
-		for ( ; ; )
-		{
-			PRINTF("\nFUNC: %s\n", __func__);
-
-			/* Check if a resource is free */
-			if (pdFALSE == pxRCB->xIsLocked)
-			{
-				/* Check if task priority is strictly greater than system priority ceiling */
-				if ( pxTCB->uxActivePriority > pxRCB->uxPriorityCeiling )
-				{
-					prvLockResource(pxRCB, pxTCB);
-
-					PRINTF("%s Locked By %s @ T : %d\n", pxRCB->pcName, pxTCB->pcName, xTaskGetTickCount());
-
-					return;
-				}
-				else
-				{
-					prvLockResource(pxRCB, pxTCB);
-
-					taskENTER_CRITICAL();
-
-					pxTCB->uxActivePriority = pxRCB->uxPriorityCeiling;
-					vTaskPrioritySet(*(pxTCB->pxTaskHandle), pxTCB->uxActivePriority);
-					
-					taskEXIT_CRITICAL();
-
-					PRINTF("%s Locked By %s\n", pxRCB->pcName, pxTCB->pcName);
-
-					return;
-
-				}
-			}
-			else
-			{
-				PRINTF("%s Denied To %s |", pxRCB->pcName, pxTCB->pcName);
-				
-				prvDenyResource(pxTCB, pxRCB->pxHolderTCB);
-				prvBlockTask(pxTCB);
-			}
-		}		
-	#endif
-
-}
-
-void vSchedulerResourceWait( ResourceHandle_t xResourceHandle)
-{
-	SchedRCB_t *pxRCB; 
-	TaskHandle_t xTaskHandle;
-	SchedTCB_t *pxTCB;
-
-	/* Check if task handle is empty*/
-	configASSERT(NULL != xResourceHandle);
-	pxRCB = prvGetRCBFromHandle(xResourceHandle);
-
-	xTaskHandle = xTaskGetCurrentTaskHandle();
-	pxTCB       = prvGetTCBFromHandle(xTaskHandle);
-
-	prvResourceWait(pxRCB, pxTCB);
-}
-
-
-
-static void prvFreeResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
-{
-	taskENTER_CRITICAL();
-
-	/* Unlock the resource*/
-	pxRCB->xIsLocked   = pdFALSE;
-	pxRCB->pxHolderTCB = NULL;
-
-	pxTCB->xHasResource--;
-
-	taskEXIT_CRITICAL();
-}
-
-static void prvUpdateTaskPriority(SchedTCB_t *pxTCB)
-{
-	UBaseType_t uxResourceIndex;
-	UBaseType_t uxResourcePriorityCeiling = tskIDLE_PRIORITY;
-
-	taskENTER_CRITICAL();
-
-	for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
-	{
-		/* Check if resource is in use */
-		if ( pdTRUE == xRCBArray[ uxResourceIndex ].xInUse )
-		{
-			/* Check if resource is locked */
-			if ( pdTRUE == xRCBArray[ uxResourceIndex ].xIsLocked )
-			{
-				/* Check if task has locked the resource */
-				if ( pxTCB == xRCBArray[ uxResourceIndex ].pxHolderTCB )
-				{
-					/* Check if priority ceiling is equal to system ceiling priority */
-					if ( uxResourcePriorityCeiling < xRCBArray[ uxResourceIndex ].uxPriorityCeiling )
-					{
-						uxResourcePriorityCeiling = xRCBArray[ uxResourceIndex ].uxPriorityCeiling;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER()
-					}
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER()
-				}
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER()
-			}
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER()
-		}
-	}
-
-	taskEXIT_CRITICAL();
-
-	if (tskIDLE_PRIORITY != uxResourcePriorityCeiling)
-	{
-		pxTCB->uxActivePriority = uxResourcePriorityCeiling;
-	}
-	else
-	{
-		pxTCB->uxActivePriority = pxTCB->uxPriority;
-	}
-
-	vTaskPrioritySet(*(pxTCB->pxTaskHandle), pxTCB->uxActivePriority);
-}
-
-static void prvUnblockTasks( SchedTCB_t *pxTCB )
-{
-	UBaseType_t uxIndex;
-	SchedTCB_t *pxTempTCB;
-
-	taskENTER_CRITICAL();
-	
-	for (uxIndex = 0; uxIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; uxIndex++)
-	{
-		pxTempTCB = &xTCBArray[uxIndex];
-
-		/* Only check tasks which are in use */
-		if (pdTRUE == pxTempTCB->xInUse)
-		{
-			/* Check if task is blocked */
-			if ( pdTRUE == pxTempTCB->xIsBlocked )
-			{
-				/* Check if task is by blocked by given task */
-				if ( *(pxTCB->pxTaskHandle) == *(pxTempTCB->pxBlockerTaskHandle) )
-				{
-					PRINTF("%s Unblocked %s @ T : %d\n", pxTempTCB->pcName, pxTCB->pcName, xTaskGetTickCount());
-
-					pxTempTCB->xIsBlocked          = pdFALSE;
-					pxTempTCB->pxBlockerTaskHandle = NULL;
-
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER()
-				}
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER()
-			}
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER()
-		}
-	}
-
-	taskEXIT_CRITICAL();
-}
-
-static void prvResourceSignal(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-
-	configASSERT( *(pxRCB->pxHolderTCB->pxTaskHandle) == *(pxTCB->pxTaskHandle) )
-
-	PRINTF("%s Freed By %s @ T : %d\n", pxRCB->pcName, pxTCB->pcName, xTaskGetTickCount());
-
-	vTaskSuspendAll();
-
-	prvFreeResource(pxRCB, pxTCB);
-
-	#if( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP)
-		prvUpdateSystemPriorityCeiling();
-	#endif
-
-	prvUpdateTaskPriority(pxTCB);
-
-	prvUnblockTasks(pxTCB);
-
-	xTaskResumeAll();
-}
-
-void vSchedulerResourceSignal( ResourceHandle_t xResourceHandle)
-{
-	SchedRCB_t *pxRCB; 
-
-	TaskHandle_t xTaskHandle;
-	SchedTCB_t *pxTCB;
-
-	/* Check if task handle is empty*/
-	configASSERT(NULL != xResourceHandle);
-
-	pxRCB = prvGetRCBFromHandle(xResourceHandle);
-
-	xTaskHandle = xTaskGetCurrentTaskHandle();
-	pxTCB = prvGetTCBFromHandle(xTaskHandle);
-
-	prvResourceSignal(pxRCB, pxTCB);
-}
-
-
-
-ResourceHandle_t xSchedulerCreateResource( const char *pcName )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-
-    SchedRCB_t *pxNewRCB;
-      
-	configASSERT( xResourceCounter < schedMAX_NUMBER_OF_RESOURCES );
-
-	pxNewRCB = &xRCBArray[ xResourceCounter ];
-
-	pxNewRCB->pcName = pcName;
-
-	pxNewRCB->pxHolderTCB = NULL;
-	pxNewRCB->uxPriorityCeiling = tskIDLE_PRIORITY;
-	pxNewRCB->xIsLocked = pdFALSE;
-
-	pxNewRCB->xUsedByTaskCounter = 0;
-
-	pxNewRCB->xInUse = pdTRUE;
-
-	xResourceCounter++;
-
-	return (ResourceHandle_t) pxNewRCB;
-}
-
-void vSchedulerResourceUsedByTask( ResourceHandle_t xResourceHandle, TaskHandle_t *pxTaskHandle )
-{
-	PRINTF("\nFUNC: %s\n", __func__);
-
-	SchedRCB_t *pxRCB; 
-
-	/* Check if task handle is empty*/
-	configASSERT(NULL != xResourceHandle);
-
-	/* Check if Resource handle is empty */
-	configASSERT(NULL != xTaskHandle);
-	
-	/* Check if too many tasks are added */
-	configASSERT(pxRCB->xUsedByTaskCounter < schedMAX_NUMBER_OF_PERIODIC_TASKS);
-
-	pxRCB = prvGetRCBFromHandle(xResourceHandle);
-
-	pxRCB->pxUsedByTask[pxRCB->xUsedByTaskCounter] = pxTaskHandle;
-	
-	pxRCB->xUsedByTaskCounter++;	
-}
-
-/************************************** RESOURCE ACCESS PROTOCOL DEFINITIONS ***********************************************/
+#include "scheduler.h"
+
+#define schedUSE_TCB_ARRAY 1
+
+#define prvGetRCBFromHandle( pxHandle )    ( SchedRCB_t * ) ( pxHandle )
+
+/* The extended TCB of every periodic task is kept in its thread local storage,
+ * so looking it up from a task handle does not scan xTCBArray. */
+#define schedTHREAD_LOCAL_STORAGE_POINTER_INDEX 0
+
+#define prvGetTCBFromHandle( x ) 		( SchedTCB_t * ) pvTaskGetThreadLocalStoragePointer( x, schedTHREAD_LOCAL_STORAGE_POINTER_INDEX )
+#define prvSetTCBForHandle( x, y ) 	vTaskSetThreadLocalStoragePointer( x, schedTHREAD_LOCAL_STORAGE_POINTER_INDEX, ( SchedTCB_t * ) y )
+
+/* Extended Task control block for managing periodic tasks within this library. */
+typedef struct xExtended_TCB
+{
+	TaskFunction_t pvTaskCode; 		/* Function pointer to the code that will be run periodically. */
+	const char *pcName; 			/* Name of the task. */
+	UBaseType_t uxStackDepth; 			/* Stack size of the task. */
+	void *pvParameters; 			/* Parameters to the task function. */
+	UBaseType_t uxPriority; 		/* Priority of the task. */
+	TaskHandle_t *pxTaskHandle;		/* Task handle for the task. */
+	TickType_t xReleaseTime;		/* Release time of the task. */
+	TickType_t xRelativeDeadline;	/* Relative deadline of the task. */
+	TickType_t xAbsoluteDeadline;	/* Absolute deadline of the task. */
+	TickType_t xPeriod;				/* Task period. */
+	TickType_t xLastWakeTime; 		/* Last time stamp when the task was running. */
+	TickType_t xMaxExecTime;		/* Worst-case execution time of the task. */
+	TickType_t xExecTime;			/* Current execution time of the task. */
+
+	BaseType_t xWorkIsDone; 		/* pdFALSE if the job is not finished, pdTRUE if the job is finished. */
+
+	#if( schedUSE_TCB_ARRAY == 1 )
+		BaseType_t xPriorityIsSet; 	/* pdTRUE if the priority is assigned. */
+		BaseType_t xInUse; 			/* pdFALSE if this extended TCB is empty. */
+	#endif
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+		BaseType_t xExecutedOnce;	/* pdTRUE if the task has executed once. */
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 || schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+		TickType_t xAbsoluteUnblockTime; /* The task will be unblocked at this time if it is blocked by the scheduler task. */
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME || schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+		BaseType_t xSuspended; 		/* pdTRUE if the task is suspended. */
+		BaseType_t xMaxExecTimeExceeded; /* pdTRUE when execTime exceeds maxExecTime. */
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+	#if( schedUSE_EXACT_EXEC_TIME == 1 )
+		uint32_t ulExecCycles;		/* CPU cycles of the current job, up to its last switch out. */
+		uint32_t ulMaxExecCycles;	/* Worst-case execution time in CPU cycles. */
+	#endif /* schedUSE_EXACT_EXEC_TIME */
+	
+	/* add if you need anything else */	
+	UBaseType_t uxActivePriority;
+	struct xRCB *pxBlockingRCB;	/* Resource whose release wakes the task while xIsBlocked. */
+	BaseType_t xIsBlocked;  
+	UBaseType_t xHasResource;
+	UBaseType_t uxHeldCeiling;	/* Highest ceiling of the resources the task holds, tskIDLE_PRIORITY if none. */
+
+} SchedTCB_t;
+
+/************************************** RESOURCE ACCESS PROTOCOL DECLARATIONS ***********************************************/
+
+/* Resource Control Block */
+typedef struct xRCB
+{
+    const char *pcName; 			    /* Name of the resource. */
+
+    SchedTCB_t *pxHolderTCB;            /* Task handle that holds the lock. */
+
+	UBaseType_t uxPriorityCeiling;	    /* Priority ceiling of the resource. */
+
+	BaseType_t xIsLocked; 			    /* pdFALSE, if this resource is not locked. */
+
+	TaskHandle_t *pxUsedByTask[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];		/* Holds all the tasks handles that may use the resource */
+
+	TickType_t xCriticalSectionTick[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];	/* Longest time in ticks each task in pxUsedByTask holds the resource. */
+
+	BaseType_t xUsedByTaskCounter;      /* Number of tasks that may hold the resource */
+
+	BaseType_t xInUse = pdFALSE; 	    /* pdFALSE, if this RCB is empty. */
+
+	/* Saved when the resource is locked and restored when it is freed. */
+	UBaseType_t uxPrevSystemPriorityCeiling;
+	struct xRCB *pxPrevSystemPriorityCeilingPointer;
+	UBaseType_t uxPrevHeldCeiling;      /* uxHeldCeiling of the holder. */
+
+} SchedRCB_t;
+
+/* Initializes the xSCArray */
+static void prvInitRCBArray( void );
+
+/* This function assigns priority ceiling to
+ * the resources based on tasks' requirement. 
+ * */
+static void prvSetPriorityCeilingToResources( void );
+
+/* These functions keep the locked resources on pxLockStack. Locks nest, so
+ * the system priority ceiling and the holder's ceiling before a lock are
+ * saved in its RCB and restored when it is freed, without scanning xRCBArray.
+ * */
+static void prvPushLock( SchedRCB_t *pxRCB );
+static void prvPopLock( SchedRCB_t *pxRCB );
+
+static void prvFreeAllResourcesHeldByTask( SchedTCB_t *pxTCB );
+
+
+
+static BaseType_t prvCheckResourcesPriorityCeilingHeldByTask( SchedTCB_t *pxTaskHandle );
+
+static void prvLockResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
+
+static void prvDenyResource(SchedTCB_t *pxBlockedTCB, SchedRCB_t *pxRCB);
+
+static void prvBlockTask(SchedTCB_t *pxTCB);
+
+static void prvResourceWait(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
+
+
+
+static void prvFreeResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
+
+static void prvUpdateTaskPriority(SchedTCB_t *pxTCB);
+
+static void prvUnblockTasks( SchedRCB_t *pxRCB );
+
+static void prvResourceSignal(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB);
+
+
+
+/* Array for RCBs. */
+static SchedRCB_t xRCBArray[ schedMAX_NUMBER_OF_RESOURCES ] = {};
+
+/* Locked resources in the order they were locked. */
+static SchedRCB_t *pxLockStack[ schedMAX_NUMBER_OF_RESOURCES ];
+
+/* Number of locked resources. */
+static UBaseType_t uxLockStackDepth = 0;
+
+/* Counter for number of resources. */
+static BaseType_t xResourceCounter = 0;
+
+/* The current system priority ceiling value */
+static UBaseType_t uxSystemPriorityCeiling = 0;
+
+/* Pointer to the current system priority ceiling RCB */
+static SchedRCB_t *pxSystemPriorityCeilingPointer = NULL;
+
+/****************************************************************************************************************************/
+
+#if( schedUSE_TCB_ARRAY == 1 )
+	static void prvInitTCBArray( void );
+	/* Find index for an empty entry in xTCBArray. Return -1 if there is no empty entry. */
+	static BaseType_t prvFindEmptyElementIndexTCB( void );
+	/* Remove a pointer to extended TCB from xTCBArray. */
+	static void prvDeleteTCBFromArray( BaseType_t xIndex );
+#endif /* schedUSE_TCB_ARRAY */
+
+static TickType_t xSystemStartTime = 0;
+
+static void prvPeriodicTaskCode( void *pvParameters );
+static BaseType_t prvCreatePeriodicTask( SchedTCB_t *pxTCB );
+static void prvCreateAllTasks( void );
+
+
+#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+	static void prvSetFixedPriorities( void );	
+#endif /* schedSCHEDULING_POLICY_RMS */
+
+#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+	static BaseType_t prvResponseTimeAnalysis( void );
+#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+	static BaseType_t prvSetOptimalPriorities( void );
+#endif /* schedSCHEDULING_POLICY_OPA */
+
+#if( schedUSE_SCHEDULER_TASK == 1 )
+	static void prvSchedulerCheckTimingError( TickType_t xTickCount, SchedTCB_t *pxTCB );
+	static TickType_t prvSchedulerEarlierEvent( TickType_t xTickCount, TickType_t xEventTick, TickType_t xDelay );
+	static TickType_t prvSchedulerNextEvent( TickType_t xTickCount, SchedTCB_t *pxTCB, TickType_t xDelay );
+	static void prvSchedulerFunction( void *pvParameters );
+	static void prvCreateSchedulerTask( void );
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+		static void prvPeriodicTaskRecreate( SchedTCB_t *pxTCB );
+		static void prvDeadlineMissedHook( SchedTCB_t *pxTCB, TickType_t xTickCount );
+		static void prvCheckDeadline( SchedTCB_t *pxTCB, TickType_t xTickCount );				
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+		static BaseType_t prvExecTimeExceedHook( TickType_t xTickCount, SchedTCB_t *pxCurrentTask );
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+	
+#endif /* schedUSE_SCHEDULER_TASK */
+
+
+
+#if( schedUSE_TCB_ARRAY == 1 )
+	/* Array for extended TCBs. */
+	static SchedTCB_t xTCBArray[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { };
+	/* Counter for number of periodic tasks. */
+	static BaseType_t xTaskCounter = 0;
+
+	/* Sets of periodic tasks, one bit per entry of xTCBArray. The scheduler
+	 * paths visit only the tasks in a set and skip 8 tasks per empty byte.
+	 * Interrupts must be off while a set that an ISR or another task also
+	 * changes is changed. */
+	#define schedTASK_SET_BYTES ( ( schedMAX_NUMBER_OF_PERIODIC_TASKS + 7 ) / 8 )
+
+	typedef struct xTaskSet
+	{
+		uint8_t ucBits[ schedTASK_SET_BYTES ];
+	} SchedTaskSet_t;
+
+	static SchedTaskSet_t xInUseSet;		/* Entries of xTCBArray in use. */
+	static SchedTaskSet_t xBlockedSet;		/* Tasks denied a resource, see prvUnblockTasks. */
+	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+		static SchedTaskSet_t xSuspendedSet;	/* Tasks that overran their WCET, until their next period. */
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+	static void prvTaskSetAdd( SchedTaskSet_t *pxSet, UBaseType_t uxIndex )
+	{
+		pxSet->ucBits[ uxIndex >> 3 ] |= ( uint8_t ) ( 1U << ( uxIndex & 7U ) );
+	}
+
+	static void prvTaskSetRemove( SchedTaskSet_t *pxSet, UBaseType_t uxIndex )
+	{
+		pxSet->ucBits[ uxIndex >> 3 ] &= ( uint8_t ) ~( 1U << ( uxIndex & 7U ) );
+	}
+
+	/* Returns the first index in pxSet at or after uxIndex, or
+	 * schedMAX_NUMBER_OF_PERIODIC_TASKS if there is none. */
+	static UBaseType_t prvTaskSetNext( const SchedTaskSet_t *pxSet, UBaseType_t uxIndex )
+	{
+		UBaseType_t uxByte = uxIndex >> 3;
+		uint8_t ucBits;
+
+		if( uxByte >= schedTASK_SET_BYTES )
+		{
+			return schedMAX_NUMBER_OF_PERIODIC_TASKS;
+		}
+
+		ucBits = pxSet->ucBits[ uxByte ] & ( uint8_t ) ( 0xFFU << ( uxIndex & 7U ) );
+		while( 0 == ucBits )
+		{
+			if( ++uxByte >= schedTASK_SET_BYTES )
+			{
+				return schedMAX_NUMBER_OF_PERIODIC_TASKS;
+			}
+			ucBits = pxSet->ucBits[ uxByte ];
+		}
+
+		return ( uxByte << 3 ) + __builtin_ctz( ucBits );
+	}
+#endif /* schedUSE_TCB_ARRAY */
+
+/* Extended TCB of the periodic task that is running, NULL while the scheduler
+ * task or the idle task runs. Maintained by vSchedulerTaskSwitchedIn. */
+static SchedTCB_t * volatile pxCurrentSchedTCB = NULL;
+
+#if( schedUSE_SCHEDULER_TASK )
+	static TaskHandle_t xSchedulerHandle = NULL; /* useful. why? */
+#endif /* schedUSE_SCHEDULER_TASK */
+
+#if( schedUSE_OVERHEAD_PROFILING == 1 || schedUSE_EXACT_EXEC_TIME == 1 || schedUSE_TIMER1_TICK == 1 )
+
+	#include <stdint.h>
+	#ifdef __AVR__
+		#include <avr/io.h>
+		#include <avr/interrupt.h>
+	#else
+		#include <time.h>
+	#endif
+
+	#ifdef __AVR__
+
+		#if( schedUSE_EXACT_EXEC_TIME == 1 && schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+			static void prvBudgetWindow( void );
+		#endif
+
+		/* Upper half of the 32 bit cycle counter. */
+		static volatile uint16_t usClockOverflows = 0;
+
+		ISR( TIMER1_OVF_vect )
+		{
+			usClockOverflows++;
+
+			#if( schedUSE_EXACT_EXEC_TIME == 1 && schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+				prvBudgetWindow();
+			#endif
+		}
+
+		/* Timer1 runs free at clk/1 and counts CPU cycles. */
+		static void prvClockInit( void )
+		{
+			TCCR1A = 0;
+			TCCR1B = _BV( CS10 );
+			TCNT1 = 0;
+			TIFR1 = _BV( TOV1 );
+			TIMSK1 |= _BV( TOIE1 );
+		}
+
+		#if( schedUSE_OVERHEAD_PROFILING == 1 || schedUSE_EXACT_EXEC_TIME == 1 )
+		static uint32_t prvClockNow( void )
+		{
+			uint8_t ucSREG = SREG;
+			cli();
+			uint16_t usLow = TCNT1;
+			uint16_t usHigh = usClockOverflows;
+			/* Overflowed while interrupts were off, not counted by the ISR yet. */
+			if( ( TIFR1 & _BV( TOV1 ) ) && usLow < 0x8000 )
+			{
+				usHigh++;
+			}
+			SREG = ucSREG;
+			return ( ( uint32_t ) usHigh << 16 ) | usLow;
+		}
+		#endif /* schedUSE_OVERHEAD_PROFILING || schedUSE_EXACT_EXEC_TIME */
+
+		#if( schedUSE_TIMER1_TICK == 1 )
+			#include <avr/wdt.h>
+
+			/* Timer1 cycles per tick. */
+			#define schedTICK_CYCLES ( ( uint16_t ) ( ( configCPU_CLOCK_HZ / 1000000UL ) * schedTICK_PERIOD_US ) )
+
+			/* The kernel tick. OCR1A moves on by whole periods, so interrupt
+			 * latency delays a tick but does not make the ticks drift. */
+			ISR( TIMER1_COMPA_vect )
+			{
+				OCR1A += schedTICK_CYCLES;
+				if( pdFALSE != xTaskIncrementTick() )
+				{
+					/* Same as the port's watchdog tick: the saved context holds this
+					 * frame, and the task returns through it when it runs again. */
+					portYIELD();
+				}
+			}
+
+			/* Stops the watchdog tick that the port started and ticks from
+			 * Timer1 instead. Must be called with interrupts off. */
+			static void prvTickStart( void )
+			{
+				wdt_disable();
+				OCR1A = TCNT1 + schedTICK_CYCLES;
+				TIFR1 = _BV( OCF1A );
+				TIMSK1 |= _BV( OCIE1A );
+			}
+		#endif /* schedUSE_TIMER1_TICK */
+
+	#else
+
+		static void prvClockInit( void )
+		{
+		}
+
+		#if( schedUSE_EXACT_EXEC_TIME == 1 )
+			/* Virtual CPU cycles of the host build, see hostCYCLES_PER_US. */
+			static uint32_t prvClockNow( void )
+			{
+				struct timespec xNow;
+				clock_gettime( CLOCK_MONOTONIC, &xNow );
+				return ( uint32_t ) ( ( uint64_t ) xNow.tv_sec * 1000000ULL * hostCYCLES_PER_US ) +
+						( uint32_t ) ( ( uint64_t ) xNow.tv_nsec * hostCYCLES_PER_US / 1000ULL );
+			}
+		#endif /* schedUSE_EXACT_EXEC_TIME */
+
+	#endif /* __AVR__ */
+
+#endif /* schedUSE_OVERHEAD_PROFILING || schedUSE_EXACT_EXEC_TIME */
+
+#if( schedUSE_EXACT_EXEC_TIME == 1 )
+
+	/* Periodic task that is running, and the cycle count at its switch in. */
+	static SchedTCB_t * volatile pxExecTCB = NULL;
+	static uint32_t ulExecSwitchInTime = 0;
+
+	/* Budget in cycles of a WCET in ticks, at most 2^31 - 1 cycles. */
+	static uint32_t prvTicksToCycles( TickType_t xTicks )
+	{
+		if( ( uint32_t ) xTicks > ( uint32_t ) INT32_MAX / schedCYCLES_PER_TICK )
+		{
+			return ( uint32_t ) INT32_MAX;
+		}
+		return ( uint32_t ) xTicks * schedCYCLES_PER_TICK;
+	}
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 && defined( __AVR__ ) )
+
+		/* A budget closer than this fires this many cycles from now. */
+		#define schedBUDGET_MIN_CYCLES 32
+
+		/* Cycle count at which the running job runs out of budget. */
+		static uint32_t ulBudgetEnd = 0;
+		static BaseType_t xBudgetArmed = pdFALSE;
+
+		/* Enables the OCR1B compare interrupt once ulBudgetEnd is less than one
+		 * Timer1 period away, the overflow interrupt calls it again until then.
+		 * Interrupts must be off. */
+		static void prvBudgetWindow( void )
+		{
+			if( pdFALSE == xBudgetArmed )
+			{
+				return;
+			}
+
+			uint32_t ulLeft = ulBudgetEnd - prvClockNow();
+
+			if( ulLeft > ( uint32_t ) INT32_MAX || ulLeft < schedBUDGET_MIN_CYCLES )
+			{
+				OCR1B = TCNT1 + schedBUDGET_MIN_CYCLES;
+			}
+			else if( ulLeft < 0x10000UL )
+			{
+				OCR1B = ( uint16_t ) ulBudgetEnd;
+			}
+			else
+			{
+				TIMSK1 &= ~_BV( OCIE1B );
+				return;
+			}
+
+			TIFR1 = _BV( OCF1B );
+			TIMSK1 |= _BV( OCIE1B );
+		}
+
+		static void prvBudgetDisarm( void )
+		{
+			xBudgetArmed = pdFALSE;
+			TIMSK1 &= ~_BV( OCIE1B );
+		}
+
+		/* Arms the budget of the job that has just been switched in. */
+		static void prvBudgetArm( SchedTCB_t *pxTCB )
+		{
+			if( pdTRUE == pxTCB->xMaxExecTimeExceeded || pdTRUE == pxTCB->xSuspended )
+			{
+				prvBudgetDisarm();
+				return;
+			}
+
+			ulBudgetEnd = ulExecSwitchInTime;
+			if( pxTCB->ulExecCycles < pxTCB->ulMaxExecCycles )
+			{
+				ulBudgetEnd += pxTCB->ulMaxExecCycles - pxTCB->ulExecCycles;
+			}
+			xBudgetArmed = pdTRUE;
+			prvBudgetWindow();
+		}
+
+		/* The running job has used up its budget. */
+		ISR( TIMER1_COMPB_vect )
+		{
+			TIMSK1 &= ~_BV( OCIE1B );
+
+			if( pdTRUE == xBudgetArmed && NULL != pxExecTCB )
+			{
+				if( ( int32_t ) ( ulBudgetEnd - prvClockNow() ) > 0 )
+				{
+					prvBudgetWindow();
+				}
+				else
+				{
+					xBudgetArmed = pdFALSE;
+					if( pdFALSE != prvExecTimeExceedHook( xTaskGetTickCountFromISR(), pxExecTCB ) )
+					{
+						#ifdef portYIELD_FROM_ISR
+							/* Runs the scheduler task now instead of at the next tick. */
+							portYIELD_FROM_ISR();
+						#endif
+					}
+				}
+			}
+		}
+
+	#else
+
+		/* Without a compare interrupt the tick hook checks the budget. */
+		#define prvBudgetArm( pxTCB )
+		#define prvBudgetDisarm()
+
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME && __AVR__ */
+
+	/* Cycles the job of pxTCB has run, with its current slice. Interrupts must be off. */
+	static uint32_t prvExecCycles( SchedTCB_t *pxTCB )
+	{
+		uint32_t ulCycles = pxTCB->ulExecCycles;
+
+		if( pxTCB == pxExecTCB )
+		{
+			ulCycles += prvClockNow() - ulExecSwitchInTime;
+		}
+		return ulCycles;
+	}
+
+	/* Starts the next job of pxTCB at zero cycles. Interrupts must be off. */
+	static void prvExecTimeReset( SchedTCB_t *pxTCB )
+	{
+		pxTCB->ulExecCycles = 0;
+
+		if( pxTCB == pxExecTCB )
+		{
+			ulExecSwitchInTime = prvClockNow();
+			prvBudgetArm( pxTCB );
+		}
+	}
+
+	/* Called from the tick hook. */
+	static void prvExecTimeTick( void )
+	{
+		#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 && !defined( __AVR__ ) )
+			SchedTCB_t *pxCurrentTask = pxExecTCB;
+
+			if( NULL != pxCurrentTask && pdFALSE == pxCurrentTask->xMaxExecTimeExceeded && pdFALSE == pxCurrentTask->xSuspended )
+			{
+				if( prvExecCycles( pxCurrentTask ) >= pxCurrentTask->ulMaxExecCycles )
+				{
+					prvExecTimeExceedHook( xTaskGetTickCountFromISR(), pxCurrentTask );
+				}
+			}
+		#endif
+	}
+
+	/* pxTCB is NULL for kernel tasks and the scheduler task. */
+	static void prvExecSwitchedIn( SchedTCB_t *pxTCB )
+	{
+		pxExecTCB = pxTCB;
+
+		if( NULL != pxTCB )
+		{
+			ulExecSwitchInTime = prvClockNow();
+			prvBudgetArm( pxTCB );
+		}
+	}
+
+	/* Called by the kernel from traceTASK_SWITCHED_OUT, with interrupts disabled. */
+	void vSchedulerTaskSwitchedOut( void )
+	{
+		SchedTCB_t *pxTCB = pxExecTCB;
+
+		if( NULL != pxTCB )
+		{
+			pxTCB->ulExecCycles += prvClockNow() - ulExecSwitchInTime;
+			prvBudgetDisarm();
+			pxExecTCB = NULL;
+		}
+	}
+
+#endif /* schedUSE_EXACT_EXEC_TIME */
+
+#if( schedUSE_OVERHEAD_PROFILING == 1 )
+
+	/* Profiling sites. */
+	#define schedPROFILE_TICK_HOOK 0
+	#define schedPROFILE_SCHEDULER 1
+	#define schedPROFILE_RESOURCE_WAIT 2
+	#define schedPROFILE_RESOURCE_SIGNAL 3
+	#define schedPROFILE_SITES 4
+
+	/* Timing statistics of one profiling site. */
+	typedef struct xProfileSite
+	{
+		const char *pcName;
+		uint32_t ulCount;
+		uint32_t ulMin;
+		uint32_t ulMax;
+		uint64_t ullTotal;
+		uint16_t usHistogram[ schedPROFILE_BINS ];	/* Saturates at 0xFFFF. */
+	} SchedProfileSite_t;
+
+	static SchedProfileSite_t xProfileSites[ schedPROFILE_SITES ] = { { "TickHook", 0, 0, 0, 0, { 0 } }, { "Scheduler", 0, 0, 0, 0, { 0 } }, { "ResourceWait", 0, 0, 0, 0, { 0 } }, { "ResourceSignal", 0, 0, 0, 0, { 0 } } };
+
+	/* Cost of reading the counter twice, taken off every sample. */
+	static uint32_t ulProfileBias = 0;
+
+	#ifdef __AVR__
+
+		#define schedPROFILE_UNIT "cycles"
+
+		static uint32_t prvProfileNow( void )
+		{
+			return prvClockNow();
+		}
+
+	#else
+
+		#define schedPROFILE_UNIT "ns"
+
+		/* Wraps every 4.29 s, longer than any site takes. */
+		static uint32_t prvProfileNow( void )
+		{
+			struct timespec xNow;
+			clock_gettime( CLOCK_MONOTONIC, &xNow );
+			return ( uint32_t ) ( ( uint64_t ) xNow.tv_sec * 1000000000ULL + ( uint64_t ) xNow.tv_nsec );
+		}
+
+	#endif /* __AVR__ */
+
+	static void prvProfileInit( void )
+	{
+		UBaseType_t uxIndex;
+
+		for( uxIndex = 0; uxIndex < schedPROFILE_SITES; uxIndex++ )
+		{
+			xProfileSites[ uxIndex ].ulMin = UINT32_MAX;
+		}
+
+		ulProfileBias = UINT32_MAX;
+		for( uxIndex = 0; uxIndex < 8; uxIndex++ )
+		{
+			uint32_t ulStart = prvProfileNow();
+			uint32_t ulElapsed = prvProfileNow() - ulStart;
+			if( ulElapsed < ulProfileBias )
+			{
+				ulProfileBias = ulElapsed;
+			}
+		}
+	}
+
+	/* Adds one sample to a site. Interrupts must be off. */
+	static void prvProfileRecord( UBaseType_t uxSite, uint32_t ulStart )
+	{
+		uint32_t ulElapsed = prvProfileNow() - ulStart;
+		SchedProfileSite_t *pxSite = &xProfileSites[ uxSite ];
+		UBaseType_t uxBin;
+
+		ulElapsed = ( ulElapsed > ulProfileBias ) ? ( ulElapsed - ulProfileBias ) : 0;
+
+		pxSite->ulCount++;
+		pxSite->ullTotal += ulElapsed;
+		if( ulElapsed < pxSite->ulMin )
+		{
+			pxSite->ulMin = ulElapsed;
+		}
+		if( ulElapsed > pxSite->ulMax )
+		{
+			pxSite->ulMax = ulElapsed;
+		}
+
+		/* Bin n holds samples below 2^( schedPROFILE_BIN_SHIFT + n ). */
+		uint32_t ulScaled = ulElapsed >> schedPROFILE_BIN_SHIFT;
+		for( uxBin = 0; 0 != ulScaled && uxBin < schedPROFILE_BINS - 1; uxBin++ )
+		{
+			ulScaled >>= 1;
+		}
+		if( UINT16_MAX != pxSite->usHistogram[ uxBin ] )
+		{
+			pxSite->usHistogram[ uxBin ]++;
+		}
+	}
+
+	void vSchedulerProfileReport( void )
+	{
+		static TickType_t xLastReport = 0;
+		SchedProfileSite_t xSite;
+		UBaseType_t uxSite, uxBin;
+
+		if( ( TickType_t ) ( xTaskGetTickCount() - xLastReport ) < schedPROFILE_REPORT_TICKS )
+		{
+			return;
+		}
+		xLastReport = xTaskGetTickCount();
+
+		PRINTF("PROF unit: %s\n", schedPROFILE_UNIT);
+		for( uxSite = 0; uxSite < schedPROFILE_SITES; uxSite++ )
+		{
+			taskENTER_CRITICAL();
+			xSite = xProfileSites[ uxSite ];
+			taskEXIT_CRITICAL();
+
+			if( 0 == xSite.ulCount )
+			{
+				continue;
+			}
+
+			PRINTF("PROF %s n=%lu min=%lu avg=%lu max=%lu\n", xSite.pcName, ( unsigned long ) xSite.ulCount, ( unsigned long ) xSite.ulMin,
+					( unsigned long ) ( xSite.ullTotal / xSite.ulCount ), ( unsigned long ) xSite.ulMax);
+			for( uxBin = 0; uxBin < schedPROFILE_BINS - 1; uxBin++ )
+			{
+				if( 0 != xSite.usHistogram[ uxBin ] )
+				{
+					PRINTF("PROF %s <%lu: %u\n", xSite.pcName, 1UL << ( schedPROFILE_BIN_SHIFT + uxBin ), xSite.usHistogram[ uxBin ]);
+				}
+			}
+			if( 0 != xSite.usHistogram[ uxBin ] )
+			{
+				PRINTF("PROF %s >=%lu: %u\n", xSite.pcName, 1UL << ( schedPROFILE_BIN_SHIFT + uxBin - 1 ), xSite.usHistogram[ uxBin ]);
+			}
+
+			/* Keeps a report from overrunning the log ring. */
+			vSchedulerLogDrain();
+		}
+	}
+
+	/* Starts timing a site. Ends in the same scope with one of the EXIT macros. */
+	#define schedPROFILE_ENTER()					uint32_t ulProfileStart = prvProfileNow()
+	/* Ends timing a site from task context. */
+	#define schedPROFILE_EXIT( uxSite )			do { taskENTER_CRITICAL(); prvProfileRecord( ( uxSite ), ulProfileStart ); taskEXIT_CRITICAL(); } while( 0 )
+	/* Ends timing a site from the tick interrupt. */
+	#define schedPROFILE_EXIT_FROM_ISR( uxSite )	prvProfileRecord( ( uxSite ), ulProfileStart )
+
+#else
+
+	#define schedPROFILE_ENTER()
+	#define schedPROFILE_EXIT( uxSite )
+	#define schedPROFILE_EXIT_FROM_ISR( uxSite )
+
+#endif /* schedUSE_OVERHEAD_PROFILING */
+
+
+#if( schedUSE_TCB_ARRAY == 1 )
+	/* Initializes xTCBArray. */
+	static void prvInitTCBArray( void )
+	{
+		UBaseType_t uxIndex;
+		for( uxIndex = 0; uxIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; uxIndex++)
+		{
+			xTCBArray[ uxIndex ].xInUse = pdFALSE;
+		}
+
+		for( uxIndex = 0; uxIndex < schedTASK_SET_BYTES; uxIndex++ )
+		{
+			xInUseSet.ucBits[ uxIndex ] = 0;
+			xBlockedSet.ucBits[ uxIndex ] = 0;
+			#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+				xSuspendedSet.ucBits[ uxIndex ] = 0;
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+		}
+	}
+
+	/* Find index for an empty entry in xTCBArray. Returns -1 if there is no empty entry. */
+	static BaseType_t prvFindEmptyElementIndexTCB( void )
+	{
+		UBaseType_t uxByte;
+
+		/* The first byte with a clear bit holds the first empty entry. */
+		for( uxByte = 0; uxByte < schedTASK_SET_BYTES; uxByte++ )
+		{
+			uint8_t ucFree = ( uint8_t ) ~xInUseSet.ucBits[ uxByte ];
+
+			if( 0 != ucFree )
+			{
+				UBaseType_t uxIndex = ( uxByte << 3 ) + __builtin_ctz( ucFree );
+				return ( uxIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS ) ? ( BaseType_t ) uxIndex : -1;
+			}
+		}
+
+		return -1;
+	}
+
+	/* Remove a pointer to extended TCB from xTCBArray. */
+	static void prvDeleteTCBFromArray( BaseType_t xIndex )
+	{
+		configASSERT(0 <= xIndex && xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS);
+		configASSERT(pdTRUE == xTCBArray[xIndex].xInUse);
+
+		if (pdTRUE == xTCBArray[xIndex].xInUse)
+		{
+			xTCBArray[xIndex].xInUse = pdFALSE;
+			xTaskCounter--;
+
+			taskENTER_CRITICAL();
+			prvTaskSetRemove( &xInUseSet, xIndex );
+			prvTaskSetRemove( &xBlockedSet, xIndex );
+			#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+				prvTaskSetRemove( &xSuspendedSet, xIndex );
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+			taskEXIT_CRITICAL();
+		}
+	}
+	
+#endif /* schedUSE_TCB_ARRAY */
+
+
+/* The whole function code that is executed by every periodic task.
+ * This function wraps the task code specified by the user. */
+static void prvPeriodicTaskCode( void *pvParameters )
+{
+	TickType_t xStartTick, xEndTick;
+	SchedTCB_t *pxThisTask;	
+	TaskHandle_t xCurrentTaskHandle = xTaskGetCurrentTaskHandle();  
+	
+	/* Check the handle is not NULL. */
+	configASSERT(NULL != xCurrentTaskHandle);
+	pxThisTask = prvGetTCBFromHandle(xCurrentTaskHandle);
+	configASSERT(NULL != pxThisTask);
+    
+	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+        pxThisTask->xExecutedOnce = pdTRUE;
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+    
+	PRINTF("\nFUNC: %s", __func__);
+	PRINTF(" -> TASK: %s, INIT RUN\n", pxThisTask->pcName);
+
+	if( 0 == pxThisTask->xReleaseTime )
+	{
+		pxThisTask->xLastWakeTime = xSystemStartTime;
+	}
+	else
+	{
+		xTaskDelayUntil(&pxThisTask->xLastWakeTime, pxThisTask->xReleaseTime);
+	}
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+		/* The scheduler task does not know this job's deadline yet. */
+		xTaskNotifyGive( xSchedulerHandle );
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+	for( ; ; )
+	{	
+		//PRINTF("TASK: %-2s\n",pxThisTask->pcName);
+			
+		pxThisTask->xWorkIsDone = pdFALSE;
+
+		xStartTick = xTaskGetTickCount();		
+		pxThisTask->pvTaskCode( pvParameters );
+		xEndTick = xTaskGetTickCount();
+   
+        pxThisTask->xWorkIsDone = pdTRUE;
+		pxThisTask->xExecTime = 0;
+		#if( schedUSE_EXACT_EXEC_TIME == 1 )
+			taskENTER_CRITICAL();
+			prvExecTimeReset( pxThisTask );
+			taskEXIT_CRITICAL();
+		#endif /* schedUSE_EXACT_EXEC_TIME */
+
+		PRINTF("STAT: %-2s, ST:%04u, ET:%04u, RT:%02u, DT: %04u\n", pxThisTask->pcName, xStartTick, xEndTick, (xEndTick - xStartTick), pxThisTask->xAbsoluteDeadline);
+		( void ) xStartTick; /* Only logged. */
+		( void ) xEndTick;
+	
+		xTaskDelayUntil(&pxThisTask->xLastWakeTime, pxThisTask->xPeriod );
+	}
+}
+
+/* Creates a periodic task. */
+void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, UBaseType_t uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
+		TaskHandle_t *pxCreatedTask, TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+
+	taskENTER_CRITICAL();
+	SchedTCB_t *pxNewTCB;
+	
+	#if( schedUSE_TCB_ARRAY == 1 )
+		BaseType_t xIndex = prvFindEmptyElementIndexTCB();
+		configASSERT( xTaskCounter < schedMAX_NUMBER_OF_PERIODIC_TASKS );
+		configASSERT( xIndex != -1 );
+		pxNewTCB = &xTCBArray[ xIndex ];	
+	#endif /* schedUSE_TCB_ARRAY */
+
+	/* Intialize item. */
+		
+	pxNewTCB->pvTaskCode = pvTaskCode;
+	pxNewTCB->pcName = pcName;
+	pxNewTCB->uxStackDepth = uxStackDepth;
+	pxNewTCB->pvParameters = pvParameters;
+	pxNewTCB->uxPriority = uxPriority;
+	pxNewTCB->pxTaskHandle = pxCreatedTask;
+	pxNewTCB->xReleaseTime = xPhaseTick;
+	pxNewTCB->xPeriod = xPeriodTick;
+	
+    /* Populate the rest */
+  	pxNewTCB->xMaxExecTime = xMaxExecTimeTick;
+  	pxNewTCB->xRelativeDeadline = xDeadlineTick;
+	pxNewTCB->xAbsoluteDeadline = pxNewTCB->xRelativeDeadline + pxNewTCB->xReleaseTime + xSystemStartTime;
+  	pxNewTCB->xWorkIsDone = pdTRUE;
+  	pxNewTCB->xExecTime = 0;
+	#if( schedUSE_EXACT_EXEC_TIME == 1 )
+		pxNewTCB->ulExecCycles = 0;
+		pxNewTCB->ulMaxExecCycles = prvTicksToCycles( xMaxExecTimeTick );
+	#endif /* schedUSE_EXACT_EXEC_TIME */
+
+	#if( schedUSE_TCB_ARRAY == 1 )
+		pxNewTCB->xInUse = pdTRUE;
+		prvTaskSetAdd( &xInUseSet, xIndex );
+	#endif /* schedUSE_TCB_ARRAY */
+	
+	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+        pxNewTCB->xPriorityIsSet = pdFALSE;
+	#endif /* schedSCHEDULING_POLICY */
+	
+	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+        pxNewTCB->xExecutedOnce = pdFALSE;
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+	
+	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+        pxNewTCB->xSuspended = pdFALSE;
+        pxNewTCB->xMaxExecTimeExceeded = pdFALSE;
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */	
+
+	#if( schedUSE_TCB_ARRAY == 1 )
+		xTaskCounter++;	
+	#endif /* schedUSE_TCB_SORTED_LIST */
+	
+	/* add if you need anything else */
+	pxNewTCB->uxActivePriority = uxPriority;
+	pxNewTCB->pxBlockingRCB = NULL;
+	pxNewTCB->xIsBlocked = pdFALSE;
+	pxNewTCB->xHasResource = 0;
+	pxNewTCB->uxHeldCeiling = tskIDLE_PRIORITY;
+
+	PRINTF("---- Task Details ----\n");
+	PRINTF("Name                : %s\n", pxNewTCB->pcName);
+	PRINTF("Phase Tick          : %u\n", pxNewTCB->xReleaseTime);
+	PRINTF("Max. Execution Tick : %u\n", pxNewTCB->xMaxExecTime);
+	PRINTF("Rel. Deadline Tick  : %u\n", pxNewTCB->xRelativeDeadline);
+	PRINTF("Period Tick         : %u\n", pxNewTCB->xPeriod);
+	PRINTF("Priority            : %d\n", pxNewTCB->uxPriority);
+	PRINTF("----------------------\n\n");
+
+	taskEXIT_CRITICAL();
+}
+
+/* Deletes a periodic task. */
+void vSchedulerPeriodicTaskDelete( TaskHandle_t xTaskHandle )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+	
+	SchedTCB_t *pxTCB;
+
+	if (NULL == xTaskHandle)
+	{
+		xTaskHandle = xTaskGetCurrentTaskHandle();
+	}
+	pxTCB = prvGetTCBFromHandle(xTaskHandle);
+	
+	configASSERT(NULL != pxTCB);
+
+	prvDeleteTCBFromArray(pxTCB - xTCBArray);
+	vTaskDelete(xTaskHandle);
+}
+
+#if( schedUSE_STATIC_ALLOCATION == 1 )
+	/* Kernel TCBs and stacks of the periodic tasks, indexed like xTCBArray. */
+	static StaticTask_t xPeriodicTaskBuffers[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+	static StackType_t xPeriodicTaskStacks[ schedMAX_NUMBER_OF_PERIODIC_TASKS ][ schedSTATIC_TASK_STACK_SIZE ];
+
+	#if( schedUSE_SCHEDULER_TASK == 1 )
+		static StaticTask_t xSchedulerTaskBuffer;
+		static StackType_t xSchedulerTaskStack[ schedSCHEDULER_TASK_STACK_SIZE ];
+	#endif /* schedUSE_SCHEDULER_TASK */
+#endif /* schedUSE_STATIC_ALLOCATION */
+
+/* Creates the kernel task of a periodic task. */
+static BaseType_t prvCreatePeriodicTask( SchedTCB_t *pxTCB )
+{
+	#if( schedUSE_STATIC_ALLOCATION == 1 )
+		UBaseType_t uxIndex = ( UBaseType_t ) ( pxTCB - xTCBArray );
+
+		configASSERT( pxTCB->uxStackDepth <= schedSTATIC_TASK_STACK_SIZE );
+
+		/* A task deleted by the scheduler task is cleaned up at once, so its
+		 * buffers can be used again right away. */
+		*pxTCB->pxTaskHandle = xTaskCreateStatic( prvPeriodicTaskCode, pxTCB->pcName, pxTCB->uxStackDepth, pxTCB->pvParameters,
+				pxTCB->uxPriority, xPeriodicTaskStacks[ uxIndex ], &xPeriodicTaskBuffers[ uxIndex ] );
+
+		return ( NULL != *pxTCB->pxTaskHandle ) ? pdPASS : pdFAIL;
+	#else
+		return xTaskCreate( prvPeriodicTaskCode, pxTCB->pcName, pxTCB->uxStackDepth, pxTCB->pvParameters, pxTCB->uxPriority, pxTCB->pxTaskHandle );
+	#endif /* schedUSE_STATIC_ALLOCATION */
+}
+
+/* Creates all periodic tasks stored in TCB array, or TCB list. */
+static void prvCreateAllTasks( void )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+	
+	SchedTCB_t *pxTCB;
+
+	#if( schedUSE_TCB_ARRAY == 1 )
+		UBaseType_t uxIndex;
+		for( uxIndex = prvTaskSetNext( &xInUseSet, 0 ); uxIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; uxIndex = prvTaskSetNext( &xInUseSet, uxIndex + 1 ) )
+		{
+			pxTCB = &xTCBArray[ uxIndex ];
+
+			BaseType_t xReturnValue = prvCreatePeriodicTask( pxTCB );
+			configASSERT( pdPASS == xReturnValue );
+			( void ) xReturnValue;
+
+			prvSetTCBForHandle(*pxTCB->pxTaskHandle, pxTCB);
+		}	
+	#endif /* schedUSE_TCB_ARRAY */
+}
+
+#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+
+	/* Initiazes fixed priorities of all periodic tasks with respect to RMS policy. */
+static void prvSetFixedPriorities( void )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+
+	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
+		PRINTF("----Using RM Scheduling Algorithm----\n");
+	#elif( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS ) 
+		PRINTF("----Using DM Scheduling Algorithm----\n");
+	#elif( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+		PRINTF("----Using Audsley OPA Algorithm----\n");
+		if( pdTRUE == prvSetOptimalPriorities() )
+		{
+			PRINTF("-------------------------------------\n\n");
+			return;
+		}
+		PRINTF("----No feasible order, using DM----\n");
+	#endif
+
+	BaseType_t xIter, xIndex;
+	TickType_t xShortest, xPreviousShortest=0;
+	SchedTCB_t *pxShortestTaskPointer = NULL, *pxTCB;
+
+	#if( schedUSE_SCHEDULER_TASK == 1 )
+		BaseType_t xHighestPriority = schedSCHEDULER_PRIORITY; 
+	#else
+		BaseType_t xHighestPriority = configMAX_PRIORITIES;
+	#endif /* schedUSE_SCHEDULER_TASK */
+
+	/* Kernel priorities between the idle task and xHighestPriority. */
+	const BaseType_t xLevels = xHighestPriority - 1 - ( BaseType_t ) tskIDLE_PRIORITY;
+	BaseType_t xGroup = -1;
+
+	configASSERT( 0 < xLevels );
+
+	/* First pass: sorts the tasks and numbers the groups of equal period (or
+	 * deadline) from 0, the shortest, in uxPriority. */
+	for( xIter = 0; xIter < xTaskCounter; xIter++ )
+	{
+		xShortest = portMAX_DELAY;
+
+		/* search for shortest period */
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			pxTCB = &xTCBArray[xIndex];
+			configASSERT(pdTRUE == pxTCB->xInUse);
+
+			if (pdFALSE == pxTCB->xPriorityIsSet)
+			{
+				#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
+					if (pxTCB->xPeriod <= xShortest)
+					{
+						xShortest = pxTCB->xPeriod;
+						pxShortestTaskPointer = pxTCB;
+					}
+				#elif( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+					if (pxTCB->xRelativeDeadline <= xShortest)
+					{
+						xShortest = pxTCB->xRelativeDeadline;
+						pxShortestTaskPointer = pxTCB;
+					}
+				#endif /* schedSCHEDULING_POLICY */
+			}
+		}
+		
+		if( ( 0 == xIter ) || ( xShortest != xPreviousShortest ) )
+		{
+			xGroup++;
+		}
+
+		pxShortestTaskPointer->uxPriority = ( UBaseType_t ) xGroup;
+		pxShortestTaskPointer->xPriorityIsSet = pdTRUE;
+
+		xPreviousShortest = xShortest;
+	}
+
+	/* Second pass: each group gets its own kernel priority, the shortest the
+	 * highest. If there are more groups than priorities, neighbouring groups
+	 * share one in order, and the response-time analysis counts the tasks of
+	 * the same priority as higher. */
+	for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+	{
+		pxTCB = &xTCBArray[ xIndex ];
+		BaseType_t xRank = ( BaseType_t ) pxTCB->uxPriority;
+
+		if( xGroup >= xLevels )
+		{
+			xRank = ( BaseType_t ) ( ( ( uint32_t ) xRank * ( uint32_t ) xLevels ) / ( uint32_t ) ( xGroup + 1 ) );
+		}
+
+		pxTCB->uxPriority = ( UBaseType_t ) ( xHighestPriority - 1 - xRank );
+		pxTCB->uxActivePriority = pxTCB->uxPriority;
+
+		#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
+			PRINTF(" Task : %s, Priority : %d, Tick : %d\n", 
+			pxTCB->pcName, pxTCB->uxPriority, pxTCB->xPeriod);
+		#else
+			PRINTF(" Task : %s, Priority : %d, Tick : %d\n", 
+			pxTCB->pcName, pxTCB->uxPriority, pxTCB->xRelativeDeadline);
+		#endif /* schedSCHEDULING_POLICY */
+	}
+	PRINTF("-------------------------------------\n");
+}
+#endif /* schedSCHEDULING_POLICY */
+
+#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+
+	/* Number of jobs of a task with period xPeriod released in ulTime ticks. */
+	static uint32_t prvJobsReleasedIn( uint32_t ulTime, TickType_t xPeriod )
+	{
+		return ( ulTime + xPeriod - 1 ) / xPeriod;
+	}
+
+	/* Returns the TCB of the task whose handle is stored at pxTaskHandle. */
+	static SchedTCB_t *prvGetTCBFromHandlePointer( TaskHandle_t *pxTaskHandle )
+	{
+		BaseType_t xIndex;
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			if( pxTaskHandle == xTCBArray[ xIndex ].pxTaskHandle )
+			{
+				return &xTCBArray[ xIndex ];
+			}
+		}
+
+		return NULL;
+	}
+
+	/* Blocking term B of pxTCB: the longest critical section of a lower
+	 * priority task on a resource whose ceiling is at least the priority of
+	 * pxTCB. OCPP and ICPP both block a job at most once, for one such
+	 * critical section, so B is the same under both. The ceilings are taken
+	 * from the fixed priorities, the tasks do not exist yet. */
+	static TickType_t prvBlockingTime( SchedTCB_t *pxTCB )
+	{
+		TickType_t xBlocking = 0;
+		BaseType_t xResourceIndex, xUserIndex;
+
+		for( xResourceIndex = 0; xResourceIndex < xResourceCounter; xResourceIndex++ )
+		{
+			SchedRCB_t *pxRCB = &xRCBArray[ xResourceIndex ];
+			UBaseType_t uxCeiling = tskIDLE_PRIORITY;
+			TickType_t xLongest = 0;
+
+			for( xUserIndex = 0; xUserIndex < pxRCB->xUsedByTaskCounter; xUserIndex++ )
+			{
+				SchedTCB_t *pxUser = prvGetTCBFromHandlePointer( pxRCB->pxUsedByTask[ xUserIndex ] );
+				configASSERT( NULL != pxUser );
+
+				if( pxUser->uxPriority > uxCeiling )
+				{
+					uxCeiling = pxUser->uxPriority;
+				}
+				if( ( pxUser->uxPriority < pxTCB->uxPriority ) && ( pxRCB->xCriticalSectionTick[ xUserIndex ] > xLongest ) )
+				{
+					xLongest = pxRCB->xCriticalSectionTick[ xUserIndex ];
+				}
+			}
+
+			if( ( uxCeiling >= pxTCB->uxPriority ) && ( xLongest > xBlocking ) )
+			{
+				xBlocking = xLongest;
+			}
+		}
+
+		return xBlocking;
+	}
+
+	/* Worst-case response time of pxTCB, from R = C + B + sum( ceil( R / Tj ) * Cj )
+	 * over the tasks that can run before it, iterated from C until R settles
+	 * or passes ulLimit. Tasks of equal priority count as higher, time slicing
+	 * can run them first. The scheduler task runs above all of them once per
+	 * job of every task, for its deadline check, for schedRTA_SCHEDULER_COST. */
+	static uint32_t prvResponseTime( SchedTCB_t *pxTCB, TickType_t xBlocking, uint32_t ulLimit )
+	{
+		uint32_t ulResponse = 0;
+		uint32_t ulNext = ( uint32_t ) pxTCB->xMaxExecTime + xBlocking;
+		BaseType_t xIndex;
+
+		while( ( ulNext != ulResponse ) && ( ulNext <= ulLimit ) )
+		{
+			ulResponse = ulNext;
+			ulNext = ( uint32_t ) pxTCB->xMaxExecTime + xBlocking;
+
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxOther = &xTCBArray[ xIndex ];
+				uint32_t ulJobs = prvJobsReleasedIn( ulResponse, pxOther->xPeriod );
+
+				if( ( pxOther != pxTCB ) && ( pxOther->uxPriority >= pxTCB->uxPriority ) )
+				{
+					ulNext += ulJobs * pxOther->xMaxExecTime;
+				}
+				ulNext += ulJobs * schedRTA_SCHEDULER_COST;
+			}
+		}
+
+		return ulNext;
+	}
+
+	/* Response-time analysis of the priorities set by prvSetFixedPriorities().
+	 * Prints the worst-case response time of every task and returns pdFALSE if
+	 * any task can miss its deadline. A task is checked against the smaller of
+	 * its deadline and period, the recurrence does not cover a job that is
+	 * still running at its next release. */
+	static BaseType_t prvResponseTimeAnalysis( void )
+	{
+		PRINTF("FUNC: %s\n", __func__);
+		#if ( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP )
+			PRINTF("----Blocking under OCPP, same bound as ICPP----\n");
+		#elif ( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_ICPP )
+			PRINTF("----Blocking under ICPP, same bound as OCPP----\n");
+		#endif
+		PRINTF("Scheduler cost per job : %d\n", schedRTA_SCHEDULER_COST);
+
+		BaseType_t xIndex;
+		BaseType_t xFeasible = pdTRUE;
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			TickType_t xLimit = ( pxTCB->xRelativeDeadline < pxTCB->xPeriod ) ? pxTCB->xRelativeDeadline : pxTCB->xPeriod;
+			TickType_t xBlocking = prvBlockingTime( pxTCB );
+			uint32_t ulResponse = prvResponseTime( pxTCB, xBlocking, xLimit );
+
+			if( ulResponse <= xLimit )
+			{
+				PRINTF(" Task : %s, B : %lu, R : %lu, D : %lu\n", pxTCB->pcName, ( unsigned long ) xBlocking, ( unsigned long ) ulResponse, ( unsigned long ) xLimit);
+			}
+			else
+			{
+				PRINTF(" Task : %s, B : %lu, R > %lu, can miss its deadline\n", pxTCB->pcName, ( unsigned long ) xBlocking, ( unsigned long ) xLimit);
+				xFeasible = pdFALSE;
+			}
+		}
+
+		if( pdFALSE == xFeasible )
+		{
+			PRINTF("----Task set is not feasible----\n");
+		}
+		PRINTF("-------------------------------------\n\n");
+
+		return xFeasible;
+	}
+
+#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+
+	/* Audsley's optimal priority assignment. Fills the priorities bottom-up:
+	 * each level goes to a task that meets its deadline there with all the
+	 * tasks not placed yet above it. The response time of a task depends on
+	 * the set of tasks above it and below it, for the blocking term, but not
+	 * on their order.
+	 * Among the tasks that fit, the one with the longest deadline is taken.
+	 * Returns pdFALSE, and leaves the priorities to be set again, if a level
+	 * has no such task or there are more tasks than levels. */
+	static BaseType_t prvSetOptimalPriorities( void )
+	{
+		/* Above every level, so the tasks not placed yet count as higher. */
+		const UBaseType_t uxUnplaced = configMAX_PRIORITIES;
+		BaseType_t xLevel, xIndex;
+		SchedTCB_t *pxTCB, *pxChosen;
+
+		#if( schedUSE_SCHEDULER_TASK == 1 )
+			const UBaseType_t uxHighestPriority = schedSCHEDULER_PRIORITY;
+		#else
+			const UBaseType_t uxHighestPriority = configMAX_PRIORITIES;
+		#endif /* schedUSE_SCHEDULER_TASK */
+
+		/* One level per task, so the priorities must be enough for all. */
+		if( ( UBaseType_t ) xTaskCounter >= uxHighestPriority - tskIDLE_PRIORITY )
+		{
+			return pdFALSE;
+		}
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			xTCBArray[ xIndex ].uxPriority = uxUnplaced;
+			xTCBArray[ xIndex ].xPriorityIsSet = pdFALSE;
+		}
+
+		for( xLevel = 0; xLevel < xTaskCounter; xLevel++ )
+		{
+			UBaseType_t uxLevel = tskIDLE_PRIORITY + 1 + xLevel;
+			configASSERT( uxLevel < uxHighestPriority );
+			pxChosen = NULL;
+
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				pxTCB = &xTCBArray[ xIndex ];
+				if( pdFALSE == pxTCB->xPriorityIsSet )
+				{
+					TickType_t xLimit = ( pxTCB->xRelativeDeadline < pxTCB->xPeriod ) ? pxTCB->xRelativeDeadline : pxTCB->xPeriod;
+
+					pxTCB->uxPriority = uxLevel;
+					if( ( prvResponseTime( pxTCB, prvBlockingTime( pxTCB ), xLimit ) <= xLimit ) &&
+						( ( NULL == pxChosen ) || ( pxTCB->xRelativeDeadline > pxChosen->xRelativeDeadline ) ) )
+					{
+						pxChosen = pxTCB;
+					}
+					pxTCB->uxPriority = uxUnplaced;
+				}
+			}
+
+			if( NULL == pxChosen )
+			{
+				for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+				{
+					xTCBArray[ xIndex ].xPriorityIsSet = pdFALSE;
+				}
+				return pdFALSE;
+			}
+
+			pxChosen->uxPriority = uxLevel;
+			pxChosen->uxActivePriority = uxLevel;
+			pxChosen->xPriorityIsSet = pdTRUE;
+
+			PRINTF(" Task : %s, Priority : %d, Tick : %d\n", 
+			pxChosen->pcName, pxChosen->uxPriority, pxChosen->xRelativeDeadline);
+		}
+
+		return pdTRUE;
+	}
+
+#endif /* schedSCHEDULING_POLICY_OPA */
+
+
+#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+
+	/* Recreates a deleted task that still has its information left in the task array (or list). */
+	static void prvPeriodicTaskRecreate( SchedTCB_t *pxTCB )
+	{
+		#if( schedUSE_TASK_RESTART == 1 )
+			/* The task starts over in prvPeriodicTaskCode with the same handle,
+			 * stack and kernel TCB, at the priority it would be created with. */
+			vTaskPrioritySet( *pxTCB->pxTaskHandle, pxTCB->uxPriority );
+			vTaskRestart( *pxTCB->pxTaskHandle );
+		#else
+			BaseType_t xReturnValue = prvCreatePeriodicTask( pxTCB );
+			configASSERT( pdPASS == xReturnValue );
+			( void ) xReturnValue;
+		#endif /* schedUSE_TASK_RESTART */
+
+		prvSetTCBForHandle(*pxTCB->pxTaskHandle, pxTCB);
+
+		pxTCB->xExecutedOnce = pdFALSE;
+		pxTCB->xSuspended = pdFALSE;
+		pxTCB->xMaxExecTimeExceeded = pdFALSE;
+
+		pxTCB->uxActivePriority = pxTCB->uxPriority;
+		pxTCB->pxBlockingRCB = NULL;
+		pxTCB->xIsBlocked = pdFALSE;
+		pxTCB->xHasResource = 0;
+		pxTCB->uxHeldCeiling = tskIDLE_PRIORITY;
+
+		taskENTER_CRITICAL();
+		prvTaskSetRemove( &xBlockedSet, pxTCB - xTCBArray );
+		#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+			prvTaskSetRemove( &xSuspendedSet, pxTCB - xTCBArray );
+		#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+		taskEXIT_CRITICAL();
+	}
+
+	/* Called when a deadline of a periodic task is missed.
+	 * Deletes the periodic task that has missed it's deadline and recreate it.
+	 * The periodic task is released during next period. */
+	static void prvDeadlineMissedHook( SchedTCB_t *pxTCB, TickType_t xTickCount )
+	{
+		PRINTF("\nFUNC: %s", __func__);
+		PRINTF(" -> TASK: %s @ T : %d\n", pxTCB->pcName, xTickCount);
+		( void ) xTickCount; /* Only logged. */
+
+		/* Free up all resources held by task */
+		prvFreeAllResourcesHeldByTask(pxTCB);
+
+		/* Delete the pxTask and recreate it. */
+		#if( schedUSE_TASK_RESTART == 0 )
+			vTaskDelete(*(pxTCB->pxTaskHandle));
+		#endif /* schedUSE_TASK_RESTART */
+		pxTCB->xExecTime = 0;
+		#if( schedUSE_EXACT_EXEC_TIME == 1 )
+			taskENTER_CRITICAL();
+			prvExecTimeReset( pxTCB );
+			taskEXIT_CRITICAL();
+		#endif /* schedUSE_EXACT_EXEC_TIME */
+		prvPeriodicTaskRecreate(pxTCB);	
+		
+		pxTCB->xReleaseTime = pxTCB->xLastWakeTime + pxTCB->xPeriod;
+		pxTCB->xAbsoluteDeadline = pxTCB->xLastWakeTime + pxTCB->xPeriod + pxTCB->xRelativeDeadline;
+	}
+
+	/* Checks whether given task has missed deadline or not. */
+	static void prvCheckDeadline( SchedTCB_t *pxTCB, TickType_t xTickCount )
+	{   
+		pxTCB->xAbsoluteDeadline = pxTCB->xLastWakeTime + pxTCB->xRelativeDeadline;
+
+		if (( signed ) ( pxTCB->xAbsoluteDeadline - xTickCount ) < 0)
+		{
+			prvDeadlineMissedHook( pxTCB, xTickCount );
+		}	
+	}	
+#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+
+#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+
+	/* Called if a periodic task has exceeded its worst-case execution time.
+	 * The periodic task is blocked until next period. A context switch to
+	 * the scheduler task occur to block the periodic task. Returns pdTRUE if
+	 * that switch should be requested from the calling ISR. In the tick hook
+	 * the kernel switches at the end of the tick anyway. */
+	static BaseType_t prvExecTimeExceedHook( TickType_t xTickCount, SchedTCB_t *pxCurrentTask )
+	{
+		PRINTF("\nFUNC: %s", __func__);
+		PRINTF(" -> TASK: %s @ T : %d\n", pxCurrentTask->pcName, xTickCount);
+		( void ) xTickCount; /* Only logged. */
+
+        pxCurrentTask->xMaxExecTimeExceeded = pdTRUE;
+        /* Is not suspended yet, but will be suspended by the scheduler later. */
+        pxCurrentTask->xSuspended = pdTRUE;
+        prvTaskSetAdd( &xSuspendedSet, pxCurrentTask - xTCBArray );
+        pxCurrentTask->xAbsoluteUnblockTime = pxCurrentTask->xLastWakeTime + pxCurrentTask->xPeriod;
+        pxCurrentTask->xExecTime = 0;
+        #if( schedUSE_EXACT_EXEC_TIME == 1 )
+            prvExecTimeReset( pxCurrentTask );
+        #endif /* schedUSE_EXACT_EXEC_TIME */
+
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR( xSchedulerHandle, &xHigherPriorityTaskWoken );
+        if( pdTRUE == xTaskResumeFromISR( xSchedulerHandle ) )
+        {
+            xHigherPriorityTaskWoken = pdTRUE;
+        }
+
+        return xHigherPriorityTaskWoken;
+	}
+#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+
+#if( schedUSE_SCHEDULER_TASK == 1 )
+	/* Called by the scheduler task. Checks all tasks for any enabled
+	 * Timing Error Detection feature. */
+	static void prvSchedulerCheckTimingError( TickType_t xTickCount, SchedTCB_t *pxTCB )
+	{
+
+		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )						
+			if ((pdTRUE == pxTCB->xWorkIsDone) && (( signed ) ( xTickCount - pxTCB->xLastWakeTime ) > 0))
+			{
+				pxTCB->xWorkIsDone = pdFALSE;
+			}
+
+			/* check if task missed deadline */
+			if ((pdTRUE == pxTCB->xExecutedOnce) && (pdFALSE == pxTCB->xWorkIsDone ))
+			{
+				prvCheckDeadline(pxTCB, xTickCount);
+			}						
+		#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+		return;
+	}
+
+	#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+	/* Called by the scheduler task for a task in xSuspendedSet. Suspends it
+	 * once it has overrun its WCET and resumes it at its next period. */
+	static void prvSchedulerCheckSuspended( TickType_t xTickCount, SchedTCB_t *pxTCB )
+	{
+        if( pdTRUE == pxTCB->xMaxExecTimeExceeded )
+        {
+			/* Free up all resources held by task */
+			prvFreeAllResourcesHeldByTask(pxTCB);
+
+            pxTCB->xMaxExecTimeExceeded = pdFALSE;
+            vTaskSuspend( *pxTCB->pxTaskHandle );
+        }
+        if( pdTRUE == pxTCB->xSuspended )
+        {
+            if( ( signed ) ( pxTCB->xAbsoluteUnblockTime - xTickCount ) <= 0 )
+            {
+                pxTCB->xSuspended = pdFALSE;
+                pxTCB->xLastWakeTime = xTickCount;
+                taskENTER_CRITICAL();
+                prvTaskSetRemove( &xSuspendedSet, pxTCB - xTCBArray );
+                taskEXIT_CRITICAL();
+                vTaskResume( *pxTCB->pxTaskHandle );
+            }
+        }
+	}
+	#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+	/* Returns the number of ticks from xTickCount to xEventTick, or xDelay if
+	 * that is sooner. Events at or before xTickCount have been handled by the
+	 * current scan. Using ICTOH method proposed by Carlini and Buttazzo. */
+	static TickType_t prvSchedulerEarlierEvent( TickType_t xTickCount, TickType_t xEventTick, TickType_t xDelay )
+	{
+		TickType_t xEventDelay = xEventTick - xTickCount;
+
+		if( ( 0 != xEventDelay ) && ( xEventDelay < ( portMAX_DELAY >> 1 ) ) && ( xEventDelay < xDelay ) )
+		{
+			xDelay = xEventDelay;
+		}
+
+		return xDelay;
+	}
+
+	/* Returns the number of ticks from xTickCount to the next deadline check
+	 * of pxTCB, or xDelay if that is sooner. Releases are not events here: the
+	 * kernel readies each job from xTaskDelayUntil(), the tick hook charges its
+	 * execution time and wakes the scheduler task on an overrun, so there is
+	 * no work for it at a release. A job that does not run in time shows up at
+	 * its deadline. Unblocking of the suspended tasks is timed from
+	 * xSuspendedSet. */
+	static TickType_t prvSchedulerNextEvent( TickType_t xTickCount, SchedTCB_t *pxTCB, TickType_t xDelay )
+	{
+		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+			if( pdTRUE == pxTCB->xExecutedOnce )
+			{
+				/* A miss is detected on the first tick after the deadline. */
+				xDelay = prvSchedulerEarlierEvent( xTickCount, pxTCB->xLastWakeTime + pxTCB->xRelativeDeadline + 1, xDelay );
+			}
+		#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+		return xDelay;
+	}
+
+	/* Function code for the scheduler task. */
+	static void prvSchedulerFunction( void *pvParameters )
+	{
+		( void ) pvParameters;
+
+		#if( schedUSE_TIMER1_TICK == 1 && defined( __AVR__ ) )
+			/* Runs before any other task, so every release is timed by Timer1. */
+			taskENTER_CRITICAL();
+			prvTickStart();
+			taskEXIT_CRITICAL();
+		#endif /* schedUSE_TIMER1_TICK */
+
+		for( ; ; )
+		{ 
+			schedPROFILE_ENTER();
+			TickType_t xDelay = portMAX_DELAY;
+
+     		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+				TickType_t xTickCount = xTaskGetTickCount();
+				UBaseType_t xIndex;
+        		SchedTCB_t *pxTCB;
+
+				#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+					/* Every task in use has a deadline to check. */
+					for (xIndex = prvTaskSetNext(&xInUseSet, 0); xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex = prvTaskSetNext(&xInUseSet, xIndex + 1))
+					{
+						pxTCB = &xTCBArray[xIndex];
+						prvSchedulerCheckTimingError(xTickCount, pxTCB);
+						xDelay = prvSchedulerNextEvent( xTickCount, pxTCB, xDelay );
+					}
+				#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+				#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+					/* Only the tasks that overran their WCET. */
+					for (xIndex = prvTaskSetNext(&xSuspendedSet, 0); xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex = prvTaskSetNext(&xSuspendedSet, xIndex + 1))
+					{
+						pxTCB = &xTCBArray[xIndex];
+						prvSchedulerCheckSuspended(xTickCount, pxTCB);
+						if( pdTRUE == pxTCB->xSuspended )
+						{
+							xDelay = prvSchedulerEarlierEvent( xTickCount, pxTCB->xAbsoluteUnblockTime, xDelay );
+						}
+					}
+				#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+			#if (schedOVERHEAD == 1)
+				TickType_t xTicks = schedOVERHEAD_TICKS;
+				while(xTicks--)
+				{
+					// Runs the CPU for one tick
+					_delay_loop_2(schedDELAY_LOOPS_PER_TICK);
+				}
+			#endif
+
+			#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+				/* The next event was computed relative to xTickCount. */
+				if( portMAX_DELAY != xDelay )
+				{
+					TickType_t xElapsed = xTaskGetTickCount() - xTickCount;
+					xDelay = ( xElapsed < xDelay ) ? ( xDelay - xElapsed ) : 0;
+				}
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+			schedPROFILE_EXIT( schedPROFILE_SCHEDULER );
+
+			/* Sleeps until the next event, or until a job notifies. */
+			ulTaskNotifyTake( pdTRUE, xDelay );
+		}
+	}
+
+	/* Creates the scheduler task. */
+	static void prvCreateSchedulerTask( void )
+	{
+		PRINTF("\nFUNC: %s\n", __func__);
+		PRINTF("---- Scheduler Details ----\n");
+		PRINTF("Priority     : %d\n", schedSCHEDULER_PRIORITY);
+		PRINTF("Overhead     : %d\n", schedOVERHEAD);
+		PRINTF("---------------------------\n");
+
+		#if( schedUSE_STATIC_ALLOCATION == 1 )
+			xSchedulerHandle = xTaskCreateStatic( (TaskFunction_t) prvSchedulerFunction, "Scheduler", schedSCHEDULER_TASK_STACK_SIZE, NULL, schedSCHEDULER_PRIORITY, xSchedulerTaskStack, &xSchedulerTaskBuffer );
+		#else
+			xTaskCreate( (TaskFunction_t) prvSchedulerFunction, "Scheduler", schedSCHEDULER_TASK_STACK_SIZE, NULL, schedSCHEDULER_PRIORITY, &xSchedulerHandle );
+		#endif /* schedUSE_STATIC_ALLOCATION */
+	}
+#endif /* schedUSE_SCHEDULER_TASK */
+
+
+#if( schedUSE_TICKLESS_IDLE == 1 )
+
+	/* Set by the tick hook, tells a watchdog wakeup from any other interrupt. */
+	static volatile BaseType_t xTicklessTicked = pdFALSE;
+
+	#ifdef __AVR__
+
+		#include <avr/io.h>
+		#include <avr/interrupt.h>
+		#include <avr/sleep.h>
+		#include <avr/wdt.h>
+
+		#ifndef portUSE_WDTO
+			#define portUSE_WDTO WDTO_15MS
+		#endif
+
+		/* Puts the watchdog in interrupt mode with timeout ucWdto. The change
+		 * must follow the enable within four cycles, as in avr-libc's wdt_enable().
+		 * Must be called with interrupts off. */
+		static void prvWatchdogInterrupt( uint8_t ucWdto )
+		{
+			uint8_t ucValue = _BV( WDIE ) | ( ( ucWdto & 0x08 ) ? _BV( WDP3 ) : 0x00 ) | ( ucWdto & 0x07 );
+
+			__asm__ __volatile__ (
+				"wdr" "\n\t"
+				"sts %0, %1" "\n\t"
+				"sts %0, %2" "\n\t"
+				: : "n" ( _SFR_MEM_ADDR( WDTCSR ) ), "r" ( ( uint8_t ) ( _BV( WDCE ) | _BV( WDE ) ) ), "r" ( ucValue )
+			);
+		}
+
+		/* pdTRUE while the UART still has bytes to send. It stops in power-down,
+		 * so the CPU only idles then. TXC0 is also clear before the first byte. */
+		static BaseType_t prvSerialBusy( void )
+		{
+			#ifdef UCSR0B
+				return ( bit_is_set( UCSR0B, UDRIE0 ) || bit_is_clear( UCSR0A, TXC0 ) ) ? pdTRUE : pdFALSE;
+			#else
+				return pdFALSE;
+			#endif
+		}
+
+		/* portSUPPRESS_TICKS_AND_SLEEP, called by the idle task with the scheduler
+		 * suspended. xExpectedIdleTime is the time to the next unblock, which is
+		 * the next release of a periodic task in xTaskDelayUntil() or the timeout
+		 * the scheduler task took from prvSchedulerNextEvent(), whichever is
+		 * sooner. The watchdog can only count a power of two of ticks, so the
+		 * time is slept in the longest of those that fit, up to
+		 * 2^schedTICKLESS_MAX_WDTO ticks each, and the kernel tick is stepped
+		 * after each one. */
+		void vSchedulerSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+		{
+			BaseType_t xWatchdogChanged = pdFALSE;
+			uint8_t ucWdto;
+
+			cli();
+			for( ;; )
+			{
+				ucWdto = 0;
+				while( ( ucWdto < schedTICKLESS_MAX_WDTO ) && ( ( ( TickType_t ) 2 << ucWdto ) <= xExpectedIdleTime ) )
+				{
+					ucWdto++;
+				}
+
+				if( ( 0 == ucWdto ) || ( eAbortSleep == eTaskConfirmSleepModeStatus() ) )
+				{
+					break;
+				}
+
+				xTicklessTicked = pdFALSE;
+				prvWatchdogInterrupt( portUSE_WDTO + ucWdto );
+				xWatchdogChanged = pdTRUE;
+
+				/* An interrupt that readies no task, or a UART interrupt in idle
+				 * mode, sends the CPU back to sleep with the watchdog running. */
+				do
+				{
+					set_sleep_mode( ( pdFALSE != prvSerialBusy() ) ? SLEEP_MODE_IDLE : SLEEP_MODE_PWR_DOWN );
+					sleep_enable();
+					sei();
+					sleep_cpu();
+					sleep_disable();
+					cli();
+				} while( ( pdFALSE == xTicklessTicked ) && ( eAbortSleep != eTaskConfirmSleepModeStatus() ) );
+
+				if( pdFALSE == xTicklessTicked )
+				{
+					/* A task was readied before the watchdog expired. Its counter
+					 * cannot be read, so at most the ticks of this sleep are lost. */
+					break;
+				}
+
+				/* The watchdog interrupt pended one tick, the others were slept.
+				 * The tick hook did not run for them, which is right: the idle
+				 * task ran, so no job is charged execution time, and every
+				 * deadline check is a timeout the kernel now sees as due. */
+				vTaskStepTick( ( ( TickType_t ) 1 << ucWdto ) - 1 );
+				xExpectedIdleTime -= ( TickType_t ) 1 << ucWdto;
+			}
+
+			if( pdFALSE != xWatchdogChanged )
+			{
+				prvWatchdogInterrupt( portUSE_WDTO );
+			}
+			sei();
+		}
+
+	#else
+
+		/* Other targets keep their tick running and do not sleep. */
+		void vSchedulerSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+		{
+			( void ) xExpectedIdleTime;
+		}
+
+	#endif /* __AVR__ */
+
+#endif /* schedUSE_TICKLESS_IDLE */
+
+#if( schedUSE_SCHEDULER_TASK == 1 )
+	/* Called every software tick. */
+	// In FreeRTOSConfig.h,
+	// Enable configUSE_TICK_HOOK
+	// Enable INCLUDE_xTaskGetIdleTaskHandle
+	// Enable INCLUDE_xTaskGetCurrentTaskHandle
+	void vApplicationTickHook( void )
+	{    
+		schedPROFILE_ENTER();
+
+		#if( schedUSE_TICKLESS_IDLE == 1 )
+			xTicklessTicked = pdTRUE;
+		#endif /* schedUSE_TICKLESS_IDLE */
+
+		#if( schedUSE_EXACT_EXEC_TIME == 1 )
+			prvExecTimeTick();
+		#else
+		/* Charged to the running job even while OCPP/ICPP has raised its priority. */
+		SchedTCB_t *pxCurrentTask = pxCurrentSchedTCB;
+
+		if( NULL != pxCurrentTask )
+		{
+			pxCurrentTask->xExecTime++;     
+     
+			#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+            if( pxCurrentTask->xMaxExecTime <= pxCurrentTask->xExecTime )
+            {
+                if( pdFALSE == pxCurrentTask->xMaxExecTimeExceeded )
+                {
+                    if( pdFALSE == pxCurrentTask->xSuspended )
+                    {
+                        prvExecTimeExceedHook( xTaskGetTickCountFromISR(), pxCurrentTask );
+                    }
+                }
+            }
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+		}
+		#endif /* schedUSE_EXACT_EXEC_TIME */
+
+		schedPROFILE_EXIT_FROM_ISR( schedPROFILE_TICK_HOOK );
+	}
+#endif /* schedUSE_SCHEDULER_TASK */
+
+/* Called by the kernel from traceTASK_SWITCHED_IN, with interrupts disabled.
+ * Kernel tasks and the scheduler task have no extended TCB. */
+void vSchedulerTaskSwitchedIn( void )
+{
+	pxCurrentSchedTCB = prvGetTCBFromHandle( xTaskGetCurrentTaskHandle() );
+
+	#if( schedUSE_EXACT_EXEC_TIME == 1 )
+		prvExecSwitchedIn( pxCurrentSchedTCB );
+	#endif /* schedUSE_EXACT_EXEC_TIME */
+}
+
+#if( DEBUG && schedLOG_DEFERRED == 1 )
+
+	#include <stdio.h>
+	#ifdef __AVR__
+		#include <util/atomic.h>
+	#endif
+
+	/* The log ring and its output are the same in every scheduler variant,
+	 * keep the copies identical. */
+
+	/* Keeps the compiler from moving memory accesses across the commit flags.
+	 * Enough on the single-core ATmega and on the host, where only one task
+	 * thread runs at a time. */
+	#define schedLOG_BARRIER() __asm__ __volatile__ ( "" ::: "memory" )
+
+	/* A stored PRINTF call. */
+	typedef struct xSchedLogRecord
+	{
+		SchedLogFormat_t xFormat;		/* Format, or its index in log_table.h. */
+		#if( schedLOG_TOKENIZED == 1 )
+			uint8_t ucStrings;			/* Bit n is set when argument n is printed with %s. */
+		#endif /* schedLOG_TOKENIZED */
+		SchedLogArg_t xArgs[ schedLOG_MAX_ARGS ];
+		uint8_t ucArgs;
+		volatile uint8_t ucCommitted; 	/* pdTRUE once the writer has filled in the record. */
+	} SchedLogRecord_t;
+
+	static SchedLogRecord_t xLogRing[ schedLOG_RING_LENGTH ];
+	/* Free running indices, masked with schedLOG_RING_LENGTH - 1. Writers
+	 * reserve at ucLogHead, vSchedulerLogDrain() prints from ucLogTail. */
+	static volatile uint8_t ucLogHead = 0;
+	static volatile uint8_t ucLogTail = 0;
+	/* Number of records dropped because the ring was full. */
+	static volatile uint8_t ucLogDropped = 0;
+	/* pdFALSE until the kernel is started, records are printed right away. */
+	static BaseType_t xLogDeferred = pdFALSE;
+
+	/* Reserves the next record. Returns pdFALSE if the ring is full. */
+	static BaseType_t prvLogReserve( uint8_t *pucIndex )
+	{
+		BaseType_t xReserved = pdFALSE;
+
+		#ifdef __AVR__
+			/* There is no compare-and-swap on the ATmega, masking interrupts
+			 * for the few cycles of the update is what the atomics do there. */
+			ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+			{
+				*pucIndex = ucLogHead;
+				if( ( uint8_t ) ( *pucIndex - ucLogTail ) < schedLOG_RING_LENGTH )
+				{
+					ucLogHead = *pucIndex + 1;
+					xReserved = pdTRUE;
+				}
+			}
+		#else
+			uint8_t ucHead = __atomic_load_n( &ucLogHead, __ATOMIC_RELAXED );
+			while( ( uint8_t ) ( ucHead - ucLogTail ) < schedLOG_RING_LENGTH )
+			{
+				if( __atomic_compare_exchange_n( &ucLogHead, &ucHead, ( uint8_t ) ( ucHead + 1 ), false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED ) )
+				{
+					*pucIndex = ucHead;
+					xReserved = pdTRUE;
+					break;
+				}
+			}
+		#endif
+
+		return xReserved;
+	}
+
+	void vSchedulerLogWrite( SchedLogFormat_t xFormat, unsigned char ucStrings, const SchedLogArg_t *pxArgs, unsigned char ucArgs )
+	{
+		uint8_t ucIndex;
+
+		if( pdTRUE == prvLogReserve( &ucIndex ) )
+		{
+			SchedLogRecord_t *pxRecord = &xLogRing[ ucIndex & ( schedLOG_RING_LENGTH - 1 ) ];
+
+			pxRecord->xFormat = xFormat;
+			#if( schedLOG_TOKENIZED == 1 )
+				pxRecord->ucStrings = ucStrings;
+			#else
+				( void ) ucStrings;
+			#endif /* schedLOG_TOKENIZED */
+			pxRecord->ucArgs = ucArgs;
+			for( uint8_t ucArg = 0; ucArg < ucArgs; ucArg++ )
+			{
+				pxRecord->xArgs[ ucArg ] = pxArgs[ ucArg ];
+			}
+			schedLOG_BARRIER();
+			pxRecord->ucCommitted = pdTRUE;
+		}
+		else
+		{
+			#ifdef __AVR__
+				ATOMIC_BLOCK( ATOMIC_RESTORESTATE )
+				{
+					ucLogDropped++;
+				}
+			#else
+				__atomic_fetch_add( &ucLogDropped, 1, __ATOMIC_RELAXED );
+			#endif
+		}
+
+		if( pdFALSE == xLogDeferred )
+		{
+			vSchedulerLogDrain();
+		}
+	}
+
+	#if( schedLOG_TOKENIZED == 1 )
+
+	/* Sends ulValue as a varint, 7 bits per byte, low bits first. */
+	static void prvLogSendVarint( unsigned long ulValue )
+	{
+		while( ulValue >= 0x80UL )
+		{
+			Serial.write( ( uint8_t ) ( ulValue | 0x80UL ) );
+			ulValue >>= 7;
+		}
+		Serial.write( ( uint8_t ) ulValue );
+	}
+
+	/* Sends a record as a frame: the format ID, then each argument in order.
+	 * Strings are sent with their NUL, cut to schedLOG_MAX_STRING characters.
+	 * Integers are zigzag encoded varints, so small negatives stay short. */
+	static void prvLogSend( const SchedLogRecord_t *pxRecord )
+	{
+		Serial.write( ( uint8_t ) pxRecord->xFormat );
+		for( uint8_t ucArg = 0; ucArg < pxRecord->ucArgs; ucArg++ )
+		{
+			const SchedLogArg_t *pxArg = &pxRecord->xArgs[ ucArg ];
+			if( 0 != ( pxRecord->ucStrings & ( 1U << ucArg ) ) )
+			{
+				const char *pcString = ( const char * ) pxArg->pvValue;
+				for( uint8_t ucChar = 0; ucChar < schedLOG_MAX_STRING && '\0' != pcString[ ucChar ]; ucChar++ )
+				{
+					Serial.write( ( uint8_t ) pcString[ ucChar ] );
+				}
+				Serial.write( ( uint8_t ) '\0' );
+			}
+			else
+			{
+				prvLogSendVarint( ( ( unsigned long ) pxArg->lValue << 1 ) ^ ( unsigned long ) ( pxArg->lValue < 0 ? -1L : 0L ) );
+			}
+		}
+	}
+
+	#else
+
+	/* Formats a record into pcBuffer. Each conversion is printed on its own,
+	 * with the argument cast back to the type its length modifier names, so
+	 * that the text is the same as printing in place. */
+	static void prvLogFormat( const SchedLogRecord_t *pxRecord, char *pcBuffer, size_t xSize )
+	{
+		const char *pcFormat = pxRecord->xFormat;
+		size_t xLength = 0;
+		uint8_t ucArg = 0;
+		char cSpec[ 12 ];
+
+		while( '\0' != *pcFormat && xLength + 1 < xSize )
+		{
+			if( '%' != *pcFormat )
+			{
+				pcBuffer[ xLength++ ] = *pcFormat++;
+				continue;
+			}
+
+			/* Flags, width, precision and length are kept. */
+			size_t xSpec = 0;
+			uint8_t ucLong = 0;
+			cSpec[ xSpec++ ] = *pcFormat++;
+			while( xSpec < sizeof( cSpec ) - 4 && ( '-' == *pcFormat || '+' == *pcFormat || ' ' == *pcFormat || '#' == *pcFormat ||
+					'.' == *pcFormat || ( '0' <= *pcFormat && '9' >= *pcFormat ) ) )
+			{
+				cSpec[ xSpec++ ] = *pcFormat++;
+			}
+			while( 'l' == *pcFormat || 'h' == *pcFormat )
+			{
+				if( 'l' == *pcFormat )
+				{
+					ucLong++;
+				}
+				if( xSpec < sizeof( cSpec ) - 2 )
+				{
+					cSpec[ xSpec++ ] = *pcFormat;
+				}
+				pcFormat++;
+			}
+
+			char cConversion = *pcFormat;
+			if( '\0' == cConversion )
+			{
+				break;
+			}
+			pcFormat++;
+
+			if( '%' == cConversion )
+			{
+				pcBuffer[ xLength++ ] = '%';
+				continue;
+			}
+			if( ucArg >= pxRecord->ucArgs )
+			{
+				break;
+			}
+
+			const SchedLogArg_t *pxArg = &pxRecord->xArgs[ ucArg++ ];
+			int iWritten;
+			cSpec[ xSpec++ ] = cConversion;
+			cSpec[ xSpec ] = '\0';
+			if( 's' == cConversion || 'p' == cConversion )
+			{
+				iWritten = snprintf( pcBuffer + xLength, xSize - xLength, cSpec, pxArg->pvValue );
+			}
+			else if( 'd' == cConversion || 'i' == cConversion || 'c' == cConversion )
+			{
+				if( 0 == ucLong )
+				{
+					iWritten = snprintf( pcBuffer + xLength, xSize - xLength, cSpec, ( int ) pxArg->lValue );
+				}
+				else if( 1 == ucLong )
+				{
+					iWritten = snprintf( pcBuffer + xLength, xSize - xLength, cSpec, pxArg->lValue );
+				}
+				else
+				{
+					iWritten = snprintf( pcBuffer + xLength, xSize - xLength, cSpec, ( long long ) pxArg->lValue );
+				}
+			}
+			else
+			{
+				if( 0 == ucLong )
+				{
+					iWritten = snprintf( pcBuffer + xLength, xSize - xLength, cSpec, ( unsigned int ) pxArg->lValue );
+				}
+				else if( 1 == ucLong )
+				{
+					iWritten = snprintf( pcBuffer + xLength, xSize - xLength, cSpec, ( unsigned long ) pxArg->lValue );
+				}
+				else
+				{
+					iWritten = snprintf( pcBuffer + xLength, xSize - xLength, cSpec, ( unsigned long long ) pxArg->lValue );
+				}
+			}
+
+			if( iWritten > 0 )
+			{
+				xLength += ( size_t ) iWritten;
+				if( xLength >= xSize )
+				{
+					xLength = xSize - 1;
+				}
+			}
+		}
+
+		pcBuffer[ xLength ] = '\0';
+	}
+
+	#endif /* schedLOG_TOKENIZED */
+
+	/* Prints the committed records in order. Called from loop(), which the idle
+	 * hook runs, so that formatting and the serial port stay out of the tasks. */
+	void vSchedulerLogDrain( void )
+	{
+		static uint8_t ucReported = 0;
+
+		#if( schedLOG_TOKENIZED == 1 )
+			static BaseType_t xHeaderSent = pdFALSE;
+
+			/* Tells the decoder where the frames start and how wide long and
+			 * int are. */
+			if( pdFALSE == xHeaderSent )
+			{
+				Serial.print( "--LOG TOKENS L" );
+				Serial.print( ( int ) sizeof( long ) );
+				Serial.print( " I" );
+				Serial.print( ( int ) sizeof( int ) );
+				Serial.print( "--\n" );
+				xHeaderSent = pdTRUE;
+			}
+		#else
+			static char cLine[ 100 ];
+		#endif /* schedLOG_TOKENIZED */
+
+		while( ucLogTail != ucLogHead )
+		{
+			SchedLogRecord_t *pxRecord = &xLogRing[ ucLogTail & ( schedLOG_RING_LENGTH - 1 ) ];
+			if( pdFALSE == pxRecord->ucCommitted )
+			{
+				/* Reserved, but still being written. */
+				break;
+			}
+			schedLOG_BARRIER();
+
+			#if( schedLOG_TOKENIZED == 1 )
+				/* Frames are short, the record is released once it is sent. */
+				prvLogSend( pxRecord );
+				pxRecord->ucCommitted = pdFALSE;
+				schedLOG_BARRIER();
+				ucLogTail = ucLogTail + 1;
+			#else
+				prvLogFormat( pxRecord, cLine, sizeof( cLine ) );
+				pxRecord->ucCommitted = pdFALSE;
+				schedLOG_BARRIER();
+				ucLogTail = ucLogTail + 1;
+
+				Serial.print( cLine );
+			#endif /* schedLOG_TOKENIZED */
+		}
+
+		uint8_t ucDropped = ucLogDropped;
+		if( ucDropped != ucReported )
+		{
+			#if( schedLOG_TOKENIZED == 1 )
+				Serial.write( ( uint8_t ) schedLOG_DROPPED_ID );
+				prvLogSendVarint( ( uint8_t ) ( ucDropped - ucReported ) );
+			#else
+				snprintf( cLine, sizeof( cLine ), "LOG: %u records dropped\n", ( unsigned int ) ( uint8_t ) ( ucDropped - ucReported ) );
+				Serial.print( cLine );
+			#endif /* schedLOG_TOKENIZED */
+			ucReported = ucDropped;
+		}
+	}
+
+#endif /* schedLOG_DEFERRED */
+
+/* This function must be called before any other function call from this module. */
+void vSchedulerInit( void )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+
+	#if( schedUSE_OVERHEAD_PROFILING == 1 || schedUSE_EXACT_EXEC_TIME == 1 || schedUSE_TIMER1_TICK == 1 )
+		prvClockInit();
+	#endif /* schedUSE_OVERHEAD_PROFILING || schedUSE_EXACT_EXEC_TIME || schedUSE_TIMER1_TICK */
+	#if( schedUSE_OVERHEAD_PROFILING == 1 )
+		prvProfileInit();
+	#endif /* schedUSE_OVERHEAD_PROFILING */
+
+	#if( schedUSE_TCB_ARRAY == 1 )
+		prvInitTCBArray();
+	#endif /* schedUSE_TCB_ARRAY */
+
+	prvInitRCBArray();
+}
+
+
+/* Starts scheduling tasks. All periodic tasks (including polling server) must
+ * have been created with API function before calling this function. */
+void vSchedulerStart( void )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+
+	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_OPA )
+		prvSetFixedPriorities();	
+	#endif /* schedSCHEDULING_POLICY */
+
+	#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+		if( pdFALSE == prvResponseTimeAnalysis() )
+		{
+			#if( schedRTA_REFUSE_INFEASIBLE == 1 )
+				PRINTF("Not started\n");
+				return;
+			#endif /* schedRTA_REFUSE_INFEASIBLE */
+		}
+	#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+	#if( schedUSE_SCHEDULER_TASK == 1 )
+		prvCreateSchedulerTask();
+	#endif /* schedUSE_SCHEDULER_TASK */
+
+	prvCreateAllTasks();
+
+	prvSetPriorityCeilingToResources();
+
+	xSystemStartTime = xTaskGetTickCount();
+	
+	#if( DEBUG && schedLOG_DEFERRED == 1 )
+		/* From here on records wait for the idle task. */
+		xLogDeferred = pdTRUE;
+	#endif /* schedLOG_DEFERRED */
+
+	vTaskStartScheduler();
+}
+
+/************************************** RESOURCE ACCESS PROTOCOL DEFINITIONS ***********************************************/
+
+static void prvInitRCBArray( void )
+{
+ 	UBaseType_t uxResourceIndex;
+	for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
+	{
+		xRCBArray[ uxResourceIndex ].xInUse = pdFALSE;
+	}   
+}
+
+static void prvSetPriorityCeilingToResources( void )
+{
+	#if ( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP )
+		PRINTF("----Using OCPP----\n");
+	#elif ( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_ICPP ) 
+		PRINTF("----Using ICPP----\n");
+	#endif
+
+	PRINTF("\nFUNC: %s\n", __func__);
+
+	UBaseType_t uxResourceIndex;
+	BaseType_t xTaskIndex;
+	UBaseType_t uxPriorityCeiling;
+
+	SchedRCB_t *pxRCB;
+
+	for( uxResourceIndex = 0; uxResourceIndex < schedMAX_NUMBER_OF_RESOURCES; uxResourceIndex++)
+	{
+		/* Check if resource is in use */
+		if ( pdTRUE == xRCBArray[ uxResourceIndex ].xInUse )
+		{ 
+			/* Start with lowest priority */
+			uxPriorityCeiling = tskIDLE_PRIORITY;
+
+			pxRCB = &xRCBArray[ uxResourceIndex ];
+
+			/* Get task with highest priority from xUsedByTask Array */
+			for( xTaskIndex = 0; xTaskIndex < pxRCB->xUsedByTaskCounter ; xTaskIndex++)
+			{
+				/* Check if priority is greater than current priority ceiling */
+				if ( uxPriorityCeiling < uxTaskPriorityGet(*(pxRCB->pxUsedByTask[ xTaskIndex ])) )
+				{
+					uxPriorityCeiling = uxTaskPriorityGet(*(pxRCB->pxUsedByTask[ xTaskIndex ]));
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* Assign highest priority to the resource */
+			pxRCB->uxPriorityCeiling = uxPriorityCeiling;
+
+			#if DEBUG
+				PRINTF("---- Resource Details ----------\n");
+				PRINTF("Name                           : %s\n", pxRCB->pcName);
+				PRINTF("Priority Ceiling               : %d\n", pxRCB->uxPriorityCeiling);
+				PRINTF("Number Of Tasks Using Resource : %d\n", pxRCB->xUsedByTaskCounter);
+				PRINTF("Tasks Utilizing Resource       : [ ");
+				for( xTaskIndex = 0; xTaskIndex < pxRCB->xUsedByTaskCounter ; xTaskIndex++)
+				{
+					PRINTF("%s ", pcTaskGetName(*(pxRCB->pxUsedByTask[ xTaskIndex ])));
+				}
+				PRINTF("]\n");
+				PRINTF("--------------------------------\n\n");
+			#endif
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+
+static void prvPushLock( SchedRCB_t *pxRCB )
+{
+	SchedTCB_t *pxTCB = pxRCB->pxHolderTCB;
+
+	configASSERT( uxLockStackDepth < schedMAX_NUMBER_OF_RESOURCES );
+
+	pxLockStack[ uxLockStackDepth++ ] = pxRCB;
+
+	pxRCB->uxPrevSystemPriorityCeiling        = uxSystemPriorityCeiling;
+	pxRCB->pxPrevSystemPriorityCeilingPointer = pxSystemPriorityCeilingPointer;
+	pxRCB->uxPrevHeldCeiling                  = pxTCB->uxHeldCeiling;
+
+	/* Check for priority ceiling */
+	if ( uxSystemPriorityCeiling < pxRCB->uxPriorityCeiling )
+	{
+		uxSystemPriorityCeiling        = pxRCB->uxPriorityCeiling;
+		pxSystemPriorityCeilingPointer = pxRCB;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER()
+	}
+
+	if ( pxTCB->uxHeldCeiling < pxRCB->uxPriorityCeiling )
+	{
+		pxTCB->uxHeldCeiling = pxRCB->uxPriorityCeiling;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER()
+	}
+}
+
+/* Freeing the top of the stack is the usual case. A resource freed out of
+ * order, e.g. by prvFreeAllResourcesHeldByTask(), is taken out by unwinding
+ * the locks above it and pushing them again. */
+static void prvPopLock( SchedRCB_t *pxRCB )
+{
+	UBaseType_t uxIndex = uxLockStackDepth;
+	UBaseType_t uxTop = uxLockStackDepth;
+	SchedRCB_t *pxTopRCB;
+
+	do
+	{
+		configASSERT( uxIndex > 0 );
+		uxIndex--;
+
+		pxTopRCB = pxLockStack[ uxIndex ];
+
+		uxSystemPriorityCeiling              = pxTopRCB->uxPrevSystemPriorityCeiling;
+		pxSystemPriorityCeilingPointer       = pxTopRCB->pxPrevSystemPriorityCeilingPointer;
+		pxTopRCB->pxHolderTCB->uxHeldCeiling = pxTopRCB->uxPrevHeldCeiling;
+	} while ( pxRCB != pxTopRCB );
+
+	uxLockStackDepth = uxIndex;
+
+	for ( uxIndex++; uxIndex < uxTop; uxIndex++ )
+	{
+		prvPushLock( pxLockStack[ uxIndex ] );
+	}
+}
+
+static void prvFreeAllResourcesHeldByTask( SchedTCB_t *pxTCB )
+{
+	UBaseType_t uxIndex;
+	SchedRCB_t *pxRCB;
+
+	if(pxTCB->xHasResource)
+	{
+		vTaskSuspendAll();
+
+		/* Only the locked resources are visited, from the top of the stack.
+		 * Freeing one moves down only the entries already visited. */
+		for( uxIndex = uxLockStackDepth; uxIndex > 0; uxIndex--)
+		{
+			pxRCB = pxLockStack[ uxIndex - 1 ];
+
+			/* Check if given task has locked the resource */
+			if ( pxTCB == pxRCB->pxHolderTCB )
+			{
+				PRINTF("%s Freed By %s\n", pxRCB->pcName, pxTCB->pcName);
+
+				prvFreeResource(pxRCB, pxTCB);
+				prvUnblockTasks(pxRCB);
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER()
+			}
+		}
+
+		xTaskResumeAll();	
+	}
+}
+
+
+
+/* Under the ceiling protocol only one task holds resources at the system
+ * ceiling, the holder of the resource that set it. */
+static BaseType_t prvCheckResourcesPriorityCeilingHeldByTask( SchedTCB_t *pxTCB )
+{
+	BaseType_t xFlag = pdFALSE;
+
+	if ( NULL != pxSystemPriorityCeilingPointer && pxTCB == pxSystemPriorityCeilingPointer->pxHolderTCB )
+	{
+		xFlag = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER()
+	}
+
+	return xFlag;
+}
+
+static void prvLockResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
+{
+	taskENTER_CRITICAL();
+
+	pxRCB->xIsLocked    = pdTRUE;
+	pxRCB->pxHolderTCB  = pxTCB;
+
+	pxTCB->xHasResource++;
+
+	prvPushLock(pxRCB);
+
+	taskEXIT_CRITICAL();
+}
+
+/* pxRCB is the resource whose release the blocked task waits for: the one it
+ * asked for, or under OCPP the one setting the system ceiling. */
+static void prvDenyResource(SchedTCB_t *pxBlockedTCB, SchedRCB_t *pxRCB)
+{
+	SchedTCB_t *pxTCB = pxRCB->pxHolderTCB;
+
+	PRINTF(" %s Blocked %s @ T : %d\n", pxBlockedTCB->pcName, pxTCB->pcName, xTaskGetTickCount());
+
+	taskENTER_CRITICAL();
+
+	pxBlockedTCB->xIsBlocked          = pdTRUE;
+	pxBlockedTCB->pxBlockingRCB = pxRCB;
+	prvTaskSetAdd( &xBlockedSet, pxBlockedTCB - xTCBArray );
+
+	#if( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP)
+		pxTCB->uxActivePriority = pxBlockedTCB->uxPriority;
+		vTaskPrioritySet(*(pxTCB->pxTaskHandle), pxTCB->uxActivePriority);
+	#endif
+
+	taskEXIT_CRITICAL();
+}
+
+/* Waits in the kernel until prvUnblockTasks() notifies the task, so the time
+ * blocked uses no CPU and is not charged to the job's execution time. A
+ * notification given before the take is counted and not lost. */
+static void prvBlockTask(SchedTCB_t *pxTCB)
+{
+	while ( pdTRUE == pxTCB->xIsBlocked )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+
+/* Each pass of the decision loop is timed on its own, without the time blocked. */
+static void prvResourceWait(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
+{
+	#if( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_OCPP)
+		for ( ; ; )
+		{
+			schedPROFILE_ENTER();
+
+			PRINTF("\nFUNC: %s\n", __func__);
+
+			/* Check if a resource is free */
+			if (pdFALSE == pxRCB->xIsLocked)
+			{
+				/* Check if task priority is strictly greater than system priority ceiling */
+				if ( pxTCB->uxActivePriority > uxSystemPriorityCeiling )
+				{
+					prvLockResource(pxRCB, pxTCB);
+
+					PRINTF("%s Locked By %s |", pxRCB->pcName, pxTCB->pcName);
+					PRINTF(" SPC : %d @ T : %d\n", uxSystemPriorityCeiling, xTaskGetTickCount());
+
+					schedPROFILE_EXIT( schedPROFILE_RESOURCE_WAIT );
+					return;
+				}
+				else
+				{
+					/* Check if task is holding any resource with priority equal to system priority ceiling */
+					if ( prvCheckResourcesPriorityCeilingHeldByTask(pxTCB) )
+					{
+
+						prvLockResource(pxRCB, pxTCB);
+
+						PRINTF("%s Locked By %s |", pxRCB->pcName, pxTCB->pcName);
+						PRINTF(" SPC : %d @ T : %d\n", uxSystemPriorityCeiling, xTaskGetTickCount());
+
+						schedPROFILE_EXIT( schedPROFILE_RESOURCE_WAIT );
+						return;
+					}
+					else
+					{
+						PRINTF("%s Denied To %s |", pxRCB->pcName, pxTCB->pcName);
+
+						prvDenyResource(pxTCB, pxSystemPriorityCeilingPointer);
+						schedPROFILE_EXIT( schedPROFILE_RESOURCE_WAIT );
+						prvBlockTask(pxTCB);
+					}
+				}
+			}
+			else
+			{
+				PRINTF("%s Denied To %s |", pxRCB->pcName, pxTCB->pcName);
+				
+				prvDenyResource(pxTCB, pxRCB);
+				schedPROFILE_EXIT( schedPROFILE_RESOURCE_WAIT );
+				prvBlockTask(pxTCB);
+			}
+		}
+	#elif( schedRESOURCE_ACCESS_PROTOCOL == schedRESOURCE_ACCESS_PROTOCOL_ICPP)
+		for ( ; ; )
+		{
+			schedPROFILE_ENTER();
+
+			PRINTF("\nFUNC: %s\n", __func__);
+
+			/* Check if a resource is free */
+			if (pdFALSE == pxRCB->xIsLocked)
+			{
+				/* Check if task priority is strictly greater than system priority ceiling */
+				if ( pxTCB->uxActivePriority > pxRCB->uxPriorityCeiling )
+				{
+					prvLockResource(pxRCB, pxTCB);
+
+					PRINTF("%s Locked By %s @ T : %d\n", pxRCB->pcName, pxTCB->pcName, xTaskGetTickCount());
+
+					schedPROFILE_EXIT( schedPROFILE_RESOURCE_WAIT );
+					return;
+				}
+				else
+				{
+					prvLockResource(pxRCB, pxTCB);
+
+					taskENTER_CRITICAL();
+
+					pxTCB->uxActivePriority = pxRCB->uxPriorityCeiling;
+					vTaskPrioritySet(*(pxTCB->pxTaskHandle), pxTCB->uxActivePriority);
+					
+					taskEXIT_CRITICAL();
+
+					PRINTF("%s Locked By %s\n", pxRCB->pcName, pxTCB->pcName);
+
+					schedPROFILE_EXIT( schedPROFILE_RESOURCE_WAIT );
+					return;
+
+				}
+			}
+			else
+			{
+				PRINTF("%s Denied To %s |", pxRCB->pcName, pxTCB->pcName);
+				
+				prvDenyResource(pxTCB, pxRCB);
+				schedPROFILE_EXIT( schedPROFILE_RESOURCE_WAIT );
+				prvBlockTask(pxTCB);
+			}
+		}		
+	#endif
+
+}
+
+void vSchedulerResourceWait( ResourceHandle_t xResourceHandle)
+{
+	SchedRCB_t *pxRCB; 
+	TaskHandle_t xTaskHandle;
+	SchedTCB_t *pxTCB;
+
+	/* Check if task handle is empty*/
+	configASSERT(NULL != xResourceHandle);
+	pxRCB = prvGetRCBFromHandle(xResourceHandle);
+
+	xTaskHandle = xTaskGetCurrentTaskHandle();
+	pxTCB       = prvGetTCBFromHandle(xTaskHandle);
+
+	prvResourceWait(pxRCB, pxTCB);
+}
+
+
+
+static void prvFreeResource(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
+{
+	taskENTER_CRITICAL();
+
+	prvPopLock(pxRCB);
+
+	/* Unlock the resource*/
+	pxRCB->xIsLocked   = pdFALSE;
+	pxRCB->pxHolderTCB = NULL;
+
+	pxTCB->xHasResource--;
+
+	taskEXIT_CRITICAL();
+}
+
+static void prvUpdateTaskPriority(SchedTCB_t *pxTCB)
+{
+	if (tskIDLE_PRIORITY != pxTCB->uxHeldCeiling)
+	{
+		pxTCB->uxActivePriority = pxTCB->uxHeldCeiling;
+	}
+	else
+	{
+		pxTCB->uxActivePriority = pxTCB->uxPriority;
+	}
+
+	vTaskPrioritySet(*(pxTCB->pxTaskHandle), pxTCB->uxActivePriority);
+}
+
+/* Wakes only the tasks waiting for pxRCB. Called with the scheduler suspended,
+ * so the woken tasks run once the caller resumes it. */
+static void prvUnblockTasks( SchedRCB_t *pxRCB )
+{
+	UBaseType_t uxIndex;
+	SchedTCB_t *pxTempTCB;
+
+	vTaskSuspendAll();
+	
+	/* Only the blocked tasks are visited. */
+	for (uxIndex = prvTaskSetNext(&xBlockedSet, 0); uxIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; uxIndex = prvTaskSetNext(&xBlockedSet, uxIndex + 1))
+	{
+		pxTempTCB = &xTCBArray[uxIndex];
+
+		/* Check if task waits for the given resource */
+		if ( pxRCB == pxTempTCB->pxBlockingRCB )
+		{
+			PRINTF("%s Unblocked %s @ T : %d\n", pxTempTCB->pcName, pxRCB->pcName, xTaskGetTickCount());
+
+			taskENTER_CRITICAL();
+			pxTempTCB->xIsBlocked    = pdFALSE;
+			pxTempTCB->pxBlockingRCB = NULL;
+			prvTaskSetRemove( &xBlockedSet, uxIndex );
+			taskEXIT_CRITICAL();
+
+			xTaskNotifyGive( *(pxTempTCB->pxTaskHandle) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER()
+		}
+	}
+
+	xTaskResumeAll();
+}
+
+static void prvResourceSignal(SchedRCB_t *pxRCB, SchedTCB_t *pxTCB)
+{
+	schedPROFILE_ENTER();
+
+	PRINTF("\nFUNC: %s\n", __func__);
+
+	configASSERT( *(pxRCB->pxHolderTCB->pxTaskHandle) == *(pxTCB->pxTaskHandle) )
+
+	PRINTF("%s Freed By %s @ T : %d\n", pxRCB->pcName, pxTCB->pcName, xTaskGetTickCount());
+
+	vTaskSuspendAll();
+
+	prvFreeResource(pxRCB, pxTCB);
+
+	prvUpdateTaskPriority(pxTCB);
+
+	prvUnblockTasks(pxRCB);
+
+	/* Stops before xTaskResumeAll(), which may switch to an unblocked task. */
+	schedPROFILE_EXIT( schedPROFILE_RESOURCE_SIGNAL );
+
+	xTaskResumeAll();
+}
+
+void vSchedulerResourceSignal( ResourceHandle_t xResourceHandle)
+{
+	SchedRCB_t *pxRCB; 
+
+	TaskHandle_t xTaskHandle;
+	SchedTCB_t *pxTCB;
+
+	/* Check if task handle is empty*/
+	configASSERT(NULL != xResourceHandle);
+
+	pxRCB = prvGetRCBFromHandle(xResourceHandle);
+
+	xTaskHandle = xTaskGetCurrentTaskHandle();
+	pxTCB = prvGetTCBFromHandle(xTaskHandle);
+
+	prvResourceSignal(pxRCB, pxTCB);
+}
+
+
+
+ResourceHandle_t xSchedulerCreateResource( const char *pcName )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+
+    SchedRCB_t *pxNewRCB;
+      
+	configASSERT( xResourceCounter < schedMAX_NUMBER_OF_RESOURCES );
+
+	pxNewRCB = &xRCBArray[ xResourceCounter ];
+
+	pxNewRCB->pcName = pcName;
+
+	pxNewRCB->pxHolderTCB = NULL;
+	pxNewRCB->uxPriorityCeiling = tskIDLE_PRIORITY;
+	pxNewRCB->xIsLocked = pdFALSE;
+
+	pxNewRCB->xUsedByTaskCounter = 0;
+
+	pxNewRCB->xInUse = pdTRUE;
+
+	xResourceCounter++;
+
+	return (ResourceHandle_t) pxNewRCB;
+}
+
+void vSchedulerResourceUsedByTask( ResourceHandle_t xResourceHandle, TaskHandle_t *pxTaskHandle, TickType_t xCriticalSectionTick )
+{
+	PRINTF("\nFUNC: %s\n", __func__);
+
+	SchedRCB_t *pxRCB; 
+
+	/* Check if task handle is empty*/
+	configASSERT(NULL != xResourceHandle);
+
+	/* Check if Resource handle is empty */
+	configASSERT(NULL != pxTaskHandle);
+	
+	pxRCB = prvGetRCBFromHandle(xResourceHandle);
+
+	/* Check if too many tasks are added */
+	configASSERT(pxRCB->xUsedByTaskCounter < schedMAX_NUMBER_OF_PERIODIC_TASKS);
+
+	pxRCB->pxUsedByTask[pxRCB->xUsedByTaskCounter] = pxTaskHandle;
+	pxRCB->xCriticalSectionTick[pxRCB->xUsedByTaskCounter] = xCriticalSectionTick;
+	
+	pxRCB->xUsedByTaskCounter++;	
+}
+
+/************************************** RESOURCE ACCESS PROTOCOL DEFINITIONS ***********************************************/